@@ -137,7 +137,7 @@ private:
 
     void calculate_population_statistics(const Population<G, T>& population)
     {
-        const std::vector<double> fitnesses = population.get_fitnesses();
+        const std::vector<double>& fitnesses = population.get_fitnesses();
 
         _mean_gen_fitnesses.push_back(calculate_mean(fitnesses));
         _median_gen_fitnesses.push_back(calculate_median(fitnesses));
@@ -180,22 +180,13 @@ private:
         //regardless of fitness. 
         //Sometimes an organism can be a domain winner and not
         //have the highest fitness. The domain winners take precedent.
-        for(const auto& org : orgs)
-            if(org.is_domain_winner())
-                return org;
+        const std::size_t first_domain_winner =
+            population.get_domain_winners().find_first();
+        if(first_domain_winner < orgs.size())
+            return orgs[first_domain_winner];
 
         //Find highest scoring organism in the population
-        std::size_t gen_winner_index = 0;
-        double gen_winner_fitness = orgs.at(gen_winner_index).get_fitness().value();
-
-        for(std::size_t i = 1; i < population.get_size(); i++)
-            if(orgs[i].get_fitness() > gen_winner_fitness)
-            {
-                gen_winner_index = i;
-                gen_winner_fitness = orgs[i].get_fitness().value();
-            }
-
-        return orgs[gen_winner_index];
+        return population.get_fittest_org();
     }
 
     void calculate_best_winner_so_far(const Organism<G, T>& gen_winner)
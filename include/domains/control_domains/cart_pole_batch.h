@@ -0,0 +1,98 @@
+#ifndef _CART_POLE_BATCH_H_
+#define _CART_POLE_BATCH_H_
+
+/*
+ * Steps many carts of the single cart pole task at once.
+ * The state variables of the carts are held in separate arrays so each update
+ * is one vectorised operation over every cart. A cart stops moving when it
+ * fails, which is done without branching by zeroing the time step of the
+ * carts that have failed. Once half of the carts being stepped have failed
+ * they are removed from the arrays, so a few long lasting carts do not keep
+ * the whole batch stepping.
+ * The arrays are indexed by slot, the position of a cart in the arrays, which
+ * changes as failed carts are removed.
+ */
+
+#include <Eigen/Dense>
+#include <vector>
+
+namespace NeuroEvo {
+
+class CartPoleBatch
+{
+
+public:
+
+    CartPoleBatch(const double gravity, const double cart_mass, const double pole_mass,
+                  const double pole_half_length, const double tau,
+                  const double boundary, const double failure_angle);
+
+    //Starts num_carts carts at rest, that have not failed and have taken no steps
+    //Cart i is in slot i until the first step
+    void reset(const std::size_t num_carts);
+
+    void set_state(const std::size_t cart, const double x, const double x_dot,
+                   const double theta, const double theta_dot);
+
+    //Applies force[i] to the cart in slot i, for every cart that has not
+    //failed, and checks which carts have failed after the step
+    void step(const Eigen::ArrayXd& force);
+
+    std::size_t get_num_slots() const;
+    std::size_t get_cart(const std::size_t slot) const;
+    bool running(const std::size_t slot) const;
+
+    bool failed(const std::size_t cart) const;
+    bool all_failed() const;
+
+    //Number of steps taken by a cart, including the step it failed on
+    unsigned get_steps(const std::size_t cart) const;
+
+    const Eigen::ArrayXd& get_x() const;
+    const Eigen::ArrayXd& get_x_dot() const;
+    const Eigen::ArrayXd& get_theta() const;
+    const Eigen::ArrayXd& get_theta_dot() const;
+
+private:
+
+    //Removes the carts that have failed from the arrays
+    void compact();
+
+    const double _gravity;
+    const double _pole_mass;
+    const double _total_mass;
+    const double _pole_half_length;
+    const double _polemass_length;
+    const double _tau;
+    const double _boundary;
+    const double _failure_angle;
+
+    Eigen::ArrayXd _x;
+    Eigen::ArrayXd _x_dot;
+    Eigen::ArrayXd _theta;
+    Eigen::ArrayXd _theta_dot;
+
+    //1 for carts that are still running and 0 for carts that have failed
+    Eigen::ArrayXd _running;
+    Eigen::ArrayXd _steps;
+
+    //Cart in each slot and slot of each cart still in the arrays
+    std::vector<std::size_t> _carts;
+    std::vector<std::size_t> _slots;
+    //Steps taken by the carts that have been removed
+    std::vector<bool> _removed;
+    std::vector<unsigned> _removed_steps;
+
+    //Intermediate values of a step, kept so stepping does not allocate
+    Eigen::ArrayXd _cos_theta;
+    Eigen::ArrayXd _sin_theta;
+    Eigen::ArrayXd _temp;
+    Eigen::ArrayXd _thetaacc;
+    Eigen::ArrayXd _xacc;
+    Eigen::ArrayXd _dt;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
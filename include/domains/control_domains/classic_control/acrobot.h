@@ -0,0 +1,190 @@
+#ifndef _ACROBOT_H_
+#define _ACROBOT_H_
+
+/*
+ * Acrobot-v1 from OpenAI gym.
+ * Two links hang from a fixed joint and a torque of -1 (action 0), 0 (action 1)
+ * or 1 (action 2) is applied at the joint between them. The goal is to swing
+ * the end of the lower link above the height of one link above the fixed
+ * joint. Every step before the goal is reached is rewarded with -1.
+ * The dynamics are the "book" dynamics of the gym version, integrated with a
+ * single Runge-Kutta step every time step.
+ */
+
+#include <domains/control_domains/classic_control/classic_control_domain.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace NeuroEvo {
+
+template <typename G>
+class Acrobot : public ClassicControlDomain<G>
+{
+
+public:
+
+    Acrobot(const double link_length_1 = 1.0, const double link_mass_1 = 1.0,
+            const double link_mass_2 = 1.0, const double link_com_pos_1 = 0.5,
+            const double link_com_pos_2 = 0.5, const double link_moi = 1.0,
+            const double dt = 0.2, const unsigned max_episode_steps = 500,
+            const bool render = false, const bool domain_trace = false,
+            const std::optional<unsigned> seed = std::nullopt) :
+        ClassicControlDomain<G>(6, 3, max_episode_steps, -100., render, domain_trace,
+                                seed),
+        _link_length_1(link_length_1),
+        _link_mass_1(link_mass_1),
+        _link_mass_2(link_mass_2),
+        _link_com_pos_1(link_com_pos_1),
+        _link_com_pos_2(link_com_pos_2),
+        _link_moi(link_moi),
+        _dt(dt) {}
+
+    Acrobot(const JSON& json) :
+        ClassicControlDomain<G>(json, 6, 3, 500, -100.),
+        _link_length_1(json.value({"link_length_1"}, 1.0)),
+        _link_mass_1(json.value({"link_mass_1"}, 1.0)),
+        _link_mass_2(json.value({"link_mass_2"}, 1.0)),
+        _link_com_pos_1(json.value({"link_com_pos_1"}, 0.5)),
+        _link_com_pos_2(json.value({"link_com_pos_2"}, 0.5)),
+        _link_moi(json.value({"link_moi"}, 1.0)),
+        _dt(json.value({"dt"}, 0.2)) {}
+
+private:
+
+    //theta1, theta2, dtheta1, dtheta2
+    typedef std::array<double, 4> State;
+
+    void reset_env(const unsigned seed) override
+    {
+        for(std::size_t i = 0; i < _state.size(); i++)
+            _state[i] = UniformRealDistribution::get(-0.1, 0.1, seed, i);
+    }
+
+    void observe(std::vector<double>& observation) const override
+    {
+        observation[0] = std::cos(_state[0]);
+        observation[1] = std::sin(_state[0]);
+        observation[2] = std::cos(_state[1]);
+        observation[3] = std::sin(_state[1]);
+        observation[4] = _state[2];
+        observation[5] = _state[3];
+    }
+
+    double step_env(const std::vector<double>& action) override
+    {
+        const double torque = action[0] - 1.;
+
+        //Runge-Kutta over one time step
+        const double dt2 = _dt / 2.;
+        const State k1 = dsdt(_state, torque);
+        const State k2 = dsdt(add(_state, dt2, k1), torque);
+        const State k3 = dsdt(add(_state, dt2, k2), torque);
+        const State k4 = dsdt(add(_state, _dt, k3), torque);
+        for(std::size_t i = 0; i < _state.size(); i++)
+            _state[i] += _dt / 6.0 * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]);
+
+        _state[0] = wrap(_state[0], -M_PI, M_PI);
+        _state[1] = wrap(_state[1], -M_PI, M_PI);
+        _state[2] = std::clamp(_state[2], -_max_vel_1, _max_vel_1);
+        _state[3] = std::clamp(_state[3], -_max_vel_2, _max_vel_2);
+
+        return terminal() ? 0. : -1.;
+    }
+
+    bool terminal() const override
+    {
+        return -std::cos(_state[0]) - std::cos(_state[1] + _state[0]) > 1.;
+    }
+
+    State dsdt(const State& s, const double a) const
+    {
+        const double m1 = _link_mass_1;
+        const double m2 = _link_mass_2;
+        const double l1 = _link_length_1;
+        const double lc1 = _link_com_pos_1;
+        const double lc2 = _link_com_pos_2;
+        const double I1 = _link_moi;
+        const double I2 = _link_moi;
+        const double g = 9.8;
+        const double theta1 = s[0];
+        const double theta2 = s[1];
+        const double dtheta1 = s[2];
+        const double dtheta2 = s[3];
+
+        const double d1 = m1 * lc1 * lc1 + m2 *
+            (l1 * l1 + lc2 * lc2 + 2 * l1 * lc2 * std::cos(theta2)) + I1 + I2;
+        const double d2 = m2 * (lc2 * lc2 + l1 * lc2 * std::cos(theta2)) + I2;
+        const double phi2 = m2 * lc2 * g * std::cos(theta1 + theta2 - M_PI / 2.);
+        const double phi1 = -m2 * l1 * lc2 * dtheta2 * dtheta2 * std::sin(theta2)
+            - 2 * m2 * l1 * lc2 * dtheta2 * dtheta1 * std::sin(theta2)
+            + (m1 * lc1 + m2 * l1) * g * std::cos(theta1 - M_PI / 2) + phi2;
+        const double ddtheta2 = (a + d2 / d1 * phi1 - m2 * l1 * lc2 * dtheta1 *
+                                 dtheta1 * std::sin(theta2) - phi2) /
+            (m2 * lc2 * lc2 + I2 - d2 * d2 / d1);
+        const double ddtheta1 = -(d2 * ddtheta2 + phi1) / d1;
+
+        return {dtheta1, dtheta2, ddtheta1, ddtheta2};
+    }
+
+    //s + h * ds
+    static State add(const State& s, const double h, const State& ds)
+    {
+        State sum;
+        for(std::size_t i = 0; i < s.size(); i++)
+            sum[i] = s[i] + h * ds[i];
+        return sum;
+    }
+
+    //Wraps x into the range [m, M]
+    static double wrap(double x, const double m, const double M)
+    {
+        const double diff = M - m;
+        while(x > M)
+            x -= diff;
+        while(x < m)
+            x += diff;
+        return x;
+    }
+
+    JSON env_to_json() const override
+    {
+        JSON json;
+        json.emplace("name", "Acrobot");
+        json.emplace("link_length_1", _link_length_1);
+        json.emplace("link_mass_1", _link_mass_1);
+        json.emplace("link_mass_2", _link_mass_2);
+        json.emplace("link_com_pos_1", _link_com_pos_1);
+        json.emplace("link_com_pos_2", _link_com_pos_2);
+        json.emplace("link_moi", _link_moi);
+        json.emplace("dt", _dt);
+        return json;
+    }
+
+    Acrobot<G>* clone_impl() const override
+    {
+        return new Acrobot<G>(*this);
+    }
+
+    const double _link_length_1;
+    const double _link_mass_1;
+    const double _link_mass_2;
+    const double _link_com_pos_1;    //position of the centre of mass of link 1
+    const double _link_com_pos_2;    //position of the centre of mass of link 2
+    const double _link_moi;          //moment of inertia of both links
+    const double _dt;
+
+    static constexpr double _max_vel_1 = 4 * M_PI;
+    static constexpr double _max_vel_2 = 9 * M_PI;
+
+    State _state;
+
+};
+
+static Factory<Domain<double, double>>::Registrar acrobot_registrar("Acrobot",
+    [](const JSON& json)
+    {return std::make_shared<Acrobot<double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef _CART_POLE_H_
+#define _CART_POLE_H_
+
+/*
+ * CartPole-v0 from OpenAI gym.
+ * A pole is balanced on a cart by pushing the cart left (action 0) or right
+ * (action 1). A reward of 1 is given for every step, including the step on
+ * which the pole falls past 12 degrees or the cart leaves the track.
+ */
+
+#include <domains/control_domains/classic_control/classic_control_domain.h>
+#include <cmath>
+
+namespace NeuroEvo {
+
+template <typename G>
+class CartPole : public ClassicControlDomain<G>
+{
+
+public:
+
+    CartPole(const double gravity = 9.8, const double cart_mass = 1.0,
+             const double pole_mass = 0.1, const double pole_half_length = 0.5,
+             const double force_mag = 10.0, const double tau = 0.02,
+             const unsigned max_episode_steps = 200,
+             const bool render = false, const bool domain_trace = false,
+             const std::optional<unsigned> seed = std::nullopt) :
+        ClassicControlDomain<G>(4, 2, max_episode_steps, 200., render, domain_trace,
+                                seed),
+        _gravity(gravity),
+        _cart_mass(cart_mass),
+        _pole_mass(pole_mass),
+        _pole_half_length(pole_half_length),
+        _force_mag(force_mag),
+        _tau(tau) {}
+
+    CartPole(const JSON& json) :
+        ClassicControlDomain<G>(json, 4, 2, 200, 200.),
+        _gravity(json.value({"gravity"}, 9.8)),
+        _cart_mass(json.value({"cart_mass"}, 1.0)),
+        _pole_mass(json.value({"pole_mass"}, 0.1)),
+        _pole_half_length(json.value({"pole_half_length"}, 0.5)),
+        _force_mag(json.value({"force_mag"}, 10.0)),
+        _tau(json.value({"tau"}, 0.02)) {}
+
+private:
+
+    void reset_env(const unsigned seed) override
+    {
+        _x = UniformRealDistribution::get(-0.05, 0.05, seed, 0);
+        _x_dot = UniformRealDistribution::get(-0.05, 0.05, seed, 1);
+        _theta = UniformRealDistribution::get(-0.05, 0.05, seed, 2);
+        _theta_dot = UniformRealDistribution::get(-0.05, 0.05, seed, 3);
+    }
+
+    void observe(std::vector<double>& observation) const override
+    {
+        observation[0] = _x;
+        observation[1] = _x_dot;
+        observation[2] = _theta;
+        observation[3] = _theta_dot;
+    }
+
+    double step_env(const std::vector<double>& action) override
+    {
+        const double total_mass = _pole_mass + _cart_mass;
+        const double polemass_length = _pole_mass * _pole_half_length;
+
+        const double force = action[0] == 1 ? _force_mag : -_force_mag;
+        const double costheta = std::cos(_theta);
+        const double sintheta = std::sin(_theta);
+
+        const double temp = (force + polemass_length * _theta_dot * _theta_dot *
+                             sintheta) / total_mass;
+        const double thetaacc = (_gravity * sintheta - costheta * temp) /
+            (_pole_half_length * (4.0 / 3.0 - _pole_mass * costheta * costheta /
+                                  total_mass));
+        const double xacc = temp - polemass_length * thetaacc * costheta / total_mass;
+
+        //Euler integration
+        _x = _x + _tau * _x_dot;
+        _x_dot = _x_dot + _tau * xacc;
+        _theta = _theta + _tau * _theta_dot;
+        _theta_dot = _theta_dot + _tau * thetaacc;
+
+        return 1.;
+    }
+
+    bool terminal() const override
+    {
+        return _x < -_x_threshold || _x > _x_threshold ||
+               _theta < -_theta_threshold || _theta > _theta_threshold;
+    }
+
+    JSON env_to_json() const override
+    {
+        JSON json;
+        json.emplace("name", "CartPole");
+        json.emplace("gravity", _gravity);
+        json.emplace("cart_mass", _cart_mass);
+        json.emplace("pole_mass", _pole_mass);
+        json.emplace("pole_half_length", _pole_half_length);
+        json.emplace("force_mag", _force_mag);
+        json.emplace("tau", _tau);
+        return json;
+    }
+
+    CartPole<G>* clone_impl() const override
+    {
+        return new CartPole<G>(*this);
+    }
+
+    const double _gravity;
+    const double _cart_mass;
+    const double _pole_mass;
+    const double _pole_half_length;
+    const double _force_mag;
+    const double _tau;    //seconds between state updates
+
+    static constexpr double _x_threshold = 2.4;
+    static constexpr double _theta_threshold = 12 * 2 * M_PI / 360;
+
+    double _x;
+    double _x_dot;
+    double _theta;
+    double _theta_dot;
+
+};
+
+static Factory<Domain<double, double>>::Registrar cart_pole_registrar("CartPole",
+    [](const JSON& json)
+    {return std::make_shared<CartPole<double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef _CLASSIC_CONTROL_DOMAIN_H_
+#define _CLASSIC_CONTROL_DOMAIN_H_
+
+/*
+ * The OpenAI gym classic control environments written natively in C++, so an
+ * episode never leaves C++ or needs a Python interpreter.
+ * Each environment implements its own dynamics, rewards and start states while
+ * this class runs the episode: the observation is handed to the control network
+ * and its outputs are turned into an action in the same way as GymDomain does,
+ * the maximum output for discrete actions and the outputs scaled to the action
+ * bounds for continuous actions. The episode ends when the environment reaches
+ * a terminal state or after the gym time limit.
+ * Episodes are coroutines, so with max_episodes over 1 the episodes of a
+ * population are run together and their observations activated in batches.
+ */
+
+#include <domains/episodic_domain.h>
+#include <phenotype/phenotype_specs/network_builder.h>
+#include <phenotype/neural_network/network_base.h>
+#include <util/maths/normalisation.h>
+#include <util/statistics/distributions/uniform_real_distribution.h>
+
+namespace NeuroEvo {
+
+template <typename G>
+class ClassicControlDomain : public EpisodicDomain<G>
+{
+
+public:
+
+    //Environment with num_actions discrete actions
+    ClassicControlDomain(const unsigned observation_size, const unsigned num_actions,
+                         const unsigned max_episode_steps,
+                         const double completion_fitness,
+                         const bool render = false, const bool domain_trace = false,
+                         const std::optional<unsigned> seed = std::nullopt) :
+        EpisodicDomain<G>(domain_trace, completion_fitness, seed, render),
+        _observation_size(observation_size),
+        _num_actions(num_actions),
+        _max_episode_steps(max_episode_steps),
+        _observation(observation_size) {}
+
+    //Environment with continuous actions bounded by action_lows and action_highs
+    ClassicControlDomain(const unsigned observation_size,
+                         const std::vector<double>& action_lows,
+                         const std::vector<double>& action_highs,
+                         const unsigned max_episode_steps,
+                         const double completion_fitness,
+                         const bool render = false, const bool domain_trace = false,
+                         const std::optional<unsigned> seed = std::nullopt) :
+        EpisodicDomain<G>(domain_trace, completion_fitness, seed, render),
+        _observation_size(observation_size),
+        _num_actions(action_lows.size()),
+        _action_lows(action_lows),
+        _action_highs(action_highs),
+        _max_episode_steps(max_episode_steps),
+        _observation(observation_size) {}
+
+    ClassicControlDomain(const JSON& json, const unsigned observation_size,
+                         const unsigned num_actions,
+                         const unsigned default_max_episode_steps,
+                         const double default_completion_fitness) :
+        EpisodicDomain<G>(json, json.value({"completion_fitness"},
+                                           default_completion_fitness)),
+        _observation_size(observation_size),
+        _num_actions(num_actions),
+        _max_episode_steps(json.value({"max_episode_steps"},
+                                      default_max_episode_steps)),
+        _observation(observation_size) {}
+
+    ClassicControlDomain(const JSON& json, const unsigned observation_size,
+                         const std::vector<double>& action_lows,
+                         const std::vector<double>& action_highs,
+                         const unsigned default_max_episode_steps,
+                         const double default_completion_fitness) :
+        EpisodicDomain<G>(json, json.value({"completion_fitness"},
+                                           default_completion_fitness)),
+        _observation_size(observation_size),
+        _num_actions(action_lows.size()),
+        _action_lows(action_lows),
+        _action_highs(action_highs),
+        _max_episode_steps(json.value({"max_episode_steps"},
+                                      default_max_episode_steps)),
+        _observation(observation_size) {}
+
+protected:
+
+    //Puts the environment in its start state, any randomness should be drawn
+    //from seed
+    virtual void reset_env(const unsigned seed) = 0;
+
+    //Writes the current observation into observation, which is already of
+    //the observation size
+    virtual void observe(std::vector<double>& observation) const = 0;
+
+    //Applies the action and returns the reward of the step. Discrete actions
+    //are handed over as a single element holding the index of the action.
+    virtual double step_env(const std::vector<double>& action) = 0;
+
+    virtual bool terminal() const = 0;
+
+    JSON to_json_impl() const override
+    {
+        JSON json = env_to_json();
+        json.emplace("max_episode_steps", _max_episode_steps);
+        json.emplace("completion_fitness", this->_completion_fitness);
+        json.emplace("max_episodes", this->_max_episodes);
+        return json;
+    }
+
+    //Name and parameters of the environment
+    virtual JSON env_to_json() const = 0;
+
+    bool is_discrete() const
+    {
+        return _action_lows.empty();
+    }
+
+    const unsigned _observation_size;
+    const unsigned _num_actions;
+
+    //Bounds of continuous actions, empty for discrete actions
+    const std::vector<double> _action_lows;
+    const std::vector<double> _action_highs;
+
+    const unsigned _max_episode_steps;
+
+private:
+
+    Episode episode(Organism<G, double>& org, unsigned rand_seed) override
+    {
+
+        //Continuous actions are scaled from the range of the final activation
+        //function to the action bounds
+        std::optional<double> out_lb, out_ub;
+        if(!is_discrete())
+        {
+            auto pheno_net = dynamic_cast<const NetworkBase*>(&org.get_phenotype());
+            if(!pheno_net)
+                throw std::runtime_error("Cannot cast phenotype to NetworkBase in "
+                    "ClassicControlDomain episode");
+            const auto final_layer_activ_func = pheno_net->get_final_layer_activ_func();
+
+            if(!(final_layer_activ_func->get_lower_bound().has_value() &&
+                 final_layer_activ_func->get_upper_bound().has_value()))
+                throw std::runtime_error("The activation function for the final "
+                    "layer of the control network for the classic control domains "
+                    "must be asymtoted on both sides");
+
+            out_lb = final_layer_activ_func->get_lower_bound().get_value();
+            out_ub = final_layer_activ_func->get_upper_bound().get_value();
+        }
+
+        std::vector<double> action(is_discrete() ? 1 : _num_actions);
+        double reward = 0.;
+
+        reset_env(rand_seed);
+
+        for(unsigned step = 0; step < _max_episode_steps; step++)
+        {
+
+            observe(_observation);
+
+            const std::vector<double>& net_outs = co_yield _observation;
+
+            if(is_discrete())
+                action[0] = std::max_element(net_outs.begin(), net_outs.end())
+                    - net_outs.begin();
+            else
+                for(std::size_t i = 0; i < _num_actions; i++)
+                    action[i] = normalise(net_outs[i], out_lb.value(), out_ub.value(),
+                                          _action_lows[i], _action_highs[i]);
+
+            this->record_step(_observation, action);
+
+            const double step_reward = step_env(action);
+            reward += step_reward;
+
+            this->record_reward(step_reward);
+
+            if(this->_domain_trace)
+            {
+                std::cout << "State: ";
+                for(const auto s : _observation)
+                    std::cout << s << " ";
+                std::cout << "  Action: ";
+                for(const auto a : action)
+                    std::cout << a << " ";
+                std::cout << "  Total reward: " << reward << std::endl;
+            }
+
+            if(this->_render)
+                render();
+
+            if(terminal())
+                break;
+
+        }
+
+        if(this->_domain_trace)
+            std::cout << "--------------------" << std::endl;
+
+        co_return reward;
+    }
+
+    bool check_phenotype_spec(const PhenotypeSpec& pheno_spec) const override
+    {
+        const NetworkBuilder* network_builder =
+            dynamic_cast<const NetworkBuilder*>(&pheno_spec);
+
+        if(network_builder == nullptr)
+        {
+            std::cerr << "Only network specifications are allowed with" <<
+                        " classic control domains!" << std::endl;
+            return false;
+        }
+
+        if(network_builder->get_num_inputs() != _observation_size)
+        {
+            std::cerr << "Number of inputs must be " << _observation_size <<
+                " for this classic control domain!" << std::endl;
+            return false;
+        }
+
+        if(network_builder->get_num_outputs() != _num_actions)
+        {
+            std::cerr << "Number of outputs must be " << _num_actions <<
+                " for this classic control domain!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void render() override {}
+
+    void exp_run_reset_impl(const unsigned, const std::optional<unsigned>&) override {}
+
+    void trial_reset(const unsigned) override {}
+
+    //Reused between steps so the episode loop does not allocate observations
+    std::vector<double> _observation;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
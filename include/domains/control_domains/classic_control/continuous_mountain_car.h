@@ -0,0 +1,129 @@
+#ifndef _CONTINUOUS_MOUNTAIN_CAR_H_
+#define _CONTINUOUS_MOUNTAIN_CAR_H_
+
+/*
+ * MountainCarContinuous-v0 from OpenAI gym.
+ * The continuous version of MountainCar where the action is a force in [-1, 1].
+ * Reaching the flag is rewarded with 100 and every step is penalised by the
+ * square of the force.
+ * If power values are given, every run uses one of them, chosen at random, as
+ * the power of the car.
+ */
+
+#include <domains/control_domains/classic_control/classic_control_domain.h>
+#include <util/statistics/distributions/uniform_unsigned_distribution.h>
+#include <algorithm>
+#include <cmath>
+
+namespace NeuroEvo {
+
+template <typename G>
+class ContinuousMountainCar : public ClassicControlDomain<G>
+{
+
+public:
+
+    ContinuousMountainCar(const double power = 0.0015,
+                          const std::optional<const std::vector<double>>&
+                              power_values = std::nullopt,
+                          const unsigned max_episode_steps = 999,
+                          const bool render = false, const bool domain_trace = false,
+                          const std::optional<unsigned> seed = std::nullopt) :
+        ClassicControlDomain<G>(2, {-1.}, {1.}, max_episode_steps, 2., render,
+                                domain_trace, seed),
+        _power(power),
+        _power_values(power_values) {}
+
+    ContinuousMountainCar(const JSON& json) :
+        ClassicControlDomain<G>(json, 2, {-1.}, {1.}, 999, 2.),
+        _power(json.value({"power"}, 0.0015)),
+        _power_values(json.optional_value<std::vector<double>>({"power_values"})) {}
+
+private:
+
+    void exp_run_reset_impl(const unsigned,
+                            const std::optional<unsigned>& run_seed) override
+    {
+        //Reset domain with a different power value
+        if(_power_values.has_value())
+        {
+            UniformUnsignedDistribution distr(0, _power_values->size()-1, run_seed);
+            _power = _power_values.value()[distr.next()];
+
+            //Set power value as domain hyperparameters
+            this->set_hyperparams(std::vector<double>(1, _power));
+        }
+    }
+
+    void reset_env(const unsigned seed) override
+    {
+        _position = UniformRealDistribution::get(-0.6, -0.4, seed, 0);
+        _velocity = 0.;
+    }
+
+    void observe(std::vector<double>& observation) const override
+    {
+        observation[0] = _position;
+        observation[1] = _velocity;
+    }
+
+    double step_env(const std::vector<double>& action) override
+    {
+        const double force = std::clamp(action[0], _min_action, _max_action);
+
+        _velocity += force * _power - 0.0025 * std::cos(3 * _position);
+        _velocity = std::clamp(_velocity, -_max_speed, _max_speed);
+        _position += _velocity;
+        _position = std::clamp(_position, _min_position, _max_position);
+        if(_position == _min_position && _velocity < 0)
+            _velocity = 0.;
+
+        double reward = terminal() ? 100. : 0.;
+        reward -= action[0] * action[0] * 0.1;
+
+        return reward;
+    }
+
+    bool terminal() const override
+    {
+        return _position >= _goal_position && _velocity >= 0.;
+    }
+
+    JSON env_to_json() const override
+    {
+        JSON json;
+        json.emplace("name", "ContinuousMountainCar");
+        json.emplace("power", _power);
+        if(_power_values.has_value())
+            json.emplace("power_values", _power_values.value());
+        return json;
+    }
+
+    ContinuousMountainCar<G>* clone_impl() const override
+    {
+        return new ContinuousMountainCar<G>(*this);
+    }
+
+    double _power;
+    const std::optional<const std::vector<double>> _power_values;
+
+    static constexpr double _min_action = -1.;
+    static constexpr double _max_action = 1.;
+    static constexpr double _min_position = -1.2;
+    static constexpr double _max_position = 0.6;
+    static constexpr double _max_speed = 0.07;
+    static constexpr double _goal_position = 0.45;
+
+    double _position;
+    double _velocity;
+
+};
+
+static Factory<Domain<double, double>>::Registrar continuous_mountain_car_registrar(
+    "ContinuousMountainCar",
+    [](const JSON& json)
+    {return std::make_shared<ContinuousMountainCar<double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
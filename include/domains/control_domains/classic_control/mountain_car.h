@@ -0,0 +1,103 @@
+#ifndef _MOUNTAIN_CAR_H_
+#define _MOUNTAIN_CAR_H_
+
+/*
+ * MountainCar-v0 from OpenAI gym.
+ * An under powered car in a valley has to rock back and forth to reach the flag
+ * on top of the right hill. The car accelerates left (action 0), not at all
+ * (action 1) or right (action 2) and receives a reward of -1 every step until
+ * it reaches the flag.
+ */
+
+#include <domains/control_domains/classic_control/classic_control_domain.h>
+#include <algorithm>
+#include <cmath>
+
+namespace NeuroEvo {
+
+template <typename G>
+class MountainCar : public ClassicControlDomain<G>
+{
+
+public:
+
+    MountainCar(const double force = 0.001, const double gravity = 0.0025,
+                const unsigned max_episode_steps = 200,
+                const bool render = false, const bool domain_trace = false,
+                const std::optional<unsigned> seed = std::nullopt) :
+        ClassicControlDomain<G>(2, 3, max_episode_steps, -110., render, domain_trace,
+                                seed),
+        _force(force),
+        _gravity(gravity) {}
+
+    MountainCar(const JSON& json) :
+        ClassicControlDomain<G>(json, 2, 3, 200, -110.),
+        _force(json.value({"force"}, 0.001)),
+        _gravity(json.value({"gravity"}, 0.0025)) {}
+
+private:
+
+    void reset_env(const unsigned seed) override
+    {
+        _position = UniformRealDistribution::get(-0.6, -0.4, seed, 0);
+        _velocity = 0.;
+    }
+
+    void observe(std::vector<double>& observation) const override
+    {
+        observation[0] = _position;
+        observation[1] = _velocity;
+    }
+
+    double step_env(const std::vector<double>& action) override
+    {
+        _velocity += (action[0] - 1) * _force + std::cos(3 * _position) * (-_gravity);
+        _velocity = std::clamp(_velocity, -_max_speed, _max_speed);
+        _position += _velocity;
+        _position = std::clamp(_position, _min_position, _max_position);
+        if(_position == _min_position && _velocity < 0)
+            _velocity = 0.;
+
+        return -1.;
+    }
+
+    bool terminal() const override
+    {
+        return _position >= _goal_position && _velocity >= 0.;
+    }
+
+    JSON env_to_json() const override
+    {
+        JSON json;
+        json.emplace("name", "MountainCar");
+        json.emplace("force", _force);
+        json.emplace("gravity", _gravity);
+        return json;
+    }
+
+    MountainCar<G>* clone_impl() const override
+    {
+        return new MountainCar<G>(*this);
+    }
+
+    const double _force;
+    const double _gravity;
+
+    static constexpr double _min_position = -1.2;
+    static constexpr double _max_position = 0.6;
+    static constexpr double _max_speed = 0.07;
+    static constexpr double _goal_position = 0.5;
+
+    double _position;
+    double _velocity;
+
+};
+
+static Factory<Domain<double, double>>::Registrar mountain_car_registrar(
+    "MountainCar",
+    [](const JSON& json)
+    {return std::make_shared<MountainCar<double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
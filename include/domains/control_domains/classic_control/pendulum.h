@@ -0,0 +1,122 @@
+#ifndef _PENDULUM_H_
+#define _PENDULUM_H_
+
+/*
+ * Pendulum-v0 from OpenAI gym.
+ * A pendulum starting at a random angle has to be swung up and held upright by
+ * applying a torque in [-2, 2] at its pivot. Every step is penalised by how far
+ * the pendulum is from upright, its speed and the torque applied. The episode
+ * only ends at the time limit.
+ */
+
+#include <domains/control_domains/classic_control/classic_control_domain.h>
+#include <algorithm>
+#include <cmath>
+
+namespace NeuroEvo {
+
+template <typename G>
+class Pendulum : public ClassicControlDomain<G>
+{
+
+public:
+
+    Pendulum(const double gravity = 10.0, const double mass = 1.0,
+             const double length = 1.0, const double dt = 0.05,
+             const unsigned max_episode_steps = 200,
+             const bool render = false, const bool domain_trace = false,
+             const std::optional<unsigned> seed = std::nullopt) :
+        ClassicControlDomain<G>(3, {-_max_torque}, {_max_torque}, max_episode_steps,
+                                100., render, domain_trace, seed),
+        _gravity(gravity),
+        _mass(mass),
+        _length(length),
+        _dt(dt) {}
+
+    Pendulum(const JSON& json) :
+        ClassicControlDomain<G>(json, 3, {-_max_torque}, {_max_torque}, 200, 100.),
+        _gravity(json.value({"gravity"}, 10.0)),
+        _mass(json.value({"mass"}, 1.0)),
+        _length(json.value({"length"}, 1.0)),
+        _dt(json.value({"dt"}, 0.05)) {}
+
+private:
+
+    void reset_env(const unsigned seed) override
+    {
+        _theta = UniformRealDistribution::get(-M_PI, M_PI, seed, 0);
+        _theta_dot = UniformRealDistribution::get(-1., 1., seed, 1);
+    }
+
+    void observe(std::vector<double>& observation) const override
+    {
+        observation[0] = std::cos(_theta);
+        observation[1] = std::sin(_theta);
+        observation[2] = _theta_dot;
+    }
+
+    double step_env(const std::vector<double>& action) override
+    {
+        const double u = std::clamp(action[0], -_max_torque, _max_torque);
+        const double theta_norm = angle_normalise(_theta);
+        const double cost = theta_norm * theta_norm + 0.1 * _theta_dot * _theta_dot +
+            0.001 * u * u;
+
+        double new_theta_dot = _theta_dot +
+            (-3 * _gravity / (2 * _length) * std::sin(_theta + M_PI) +
+             3. / (_mass * _length * _length) * u) * _dt;
+        _theta = _theta + new_theta_dot * _dt;
+        _theta_dot = std::clamp(new_theta_dot, -_max_speed, _max_speed);
+
+        return -cost;
+    }
+
+    bool terminal() const override
+    {
+        return false;
+    }
+
+    //Maps an angle to [-pi, pi) with the floored modulo that gym uses
+    static double angle_normalise(const double x)
+    {
+        const double two_pi = 2 * M_PI;
+        const double shifted = x + M_PI;
+        return shifted - two_pi * std::floor(shifted / two_pi) - M_PI;
+    }
+
+    JSON env_to_json() const override
+    {
+        JSON json;
+        json.emplace("name", "Pendulum");
+        json.emplace("gravity", _gravity);
+        json.emplace("mass", _mass);
+        json.emplace("length", _length);
+        json.emplace("dt", _dt);
+        return json;
+    }
+
+    Pendulum<G>* clone_impl() const override
+    {
+        return new Pendulum<G>(*this);
+    }
+
+    const double _gravity;
+    const double _mass;
+    const double _length;
+    const double _dt;
+
+    static constexpr double _max_speed = 8.;
+    static constexpr double _max_torque = 2.;
+
+    double _theta;
+    double _theta_dot;
+
+};
+
+static Factory<Domain<double, double>>::Registrar pendulum_registrar("Pendulum",
+    [](const JSON& json)
+    {return std::make_shared<Pendulum<double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
@@ -2,8 +2,17 @@
 #define _GYM_DOMAIN_H_
 
 /*
- * An OpenAI Gym environment; it uses the http gym binding to communicate with
- * a flask http server servicing OpenAI Gym.
+ * An OpenAI Gym environment run through embedded Python.
+ * Observations, actions and step results are passed through buffers owned by
+ * this class that the Python side views in place, so a step is a single
+ * function call with no conversion of lists between C++ and Python.
+ * Alternatively the environments can be run in worker processes, each with
+ * its own interpreter and environment. Copies of the domain share the workers
+ * and every episode borrows one, so episodes run in parallel are not held up
+ * by the GIL or by sharing one environment.
+ * With a batch size above one, the population is evaluated in batches of that
+ * many episodes, whose environments are all stepped by a single call into
+ * Python or a single message to a worker.
  */
 
 #include <domains/domain.h>
@@ -11,6 +20,8 @@
 #include <domains/control_domains/gym/space.h>
 #include <phenotype/phenotype_specs/network_builder.h>
 #include <util/maths/normalisation.h>
+#include <domains/control_domains/gym/gym_worker.h>
+#include <util/concurrency/clone_pool.h>
 
 namespace NeuroEvo {
 
@@ -37,7 +48,7 @@ public:
     friend std::ostream& operator<<(std::ostream& os,
                                     const GymMakeKwargs& gym_make_kwargs)
     {
-        for(const auto kwarg : gym_make_kwargs._kwargs)
+        for(const auto& kwarg : gym_make_kwargs._kwargs)
             os << kwarg.first << " " << kwarg.second << std::endl;
         return os;
     }
@@ -59,98 +70,283 @@ public:
               const double max_reward = 1e6,
               const bool render = false,
               const bool domain_trace = false,
-              const std::optional<const unsigned> seed = std::nullopt) :
+              const std::optional<const unsigned> seed = std::nullopt,
+              const bool worker_processes = false,
+              const unsigned batch_size = 1) :
         Domain<G, double>(domain_trace, max_reward, seed, render),
         _kwargs(kwargs),
-        _gym_module(initialise_gym_module()),
+        _gym_env_id(gym_env_id),
+        _gym_module(worker_processes ? std::nullopt :
+                    std::optional<PythonModule>(initialise_gym_module())),
+        _batch_size(batch_size),
         _action_space_type(action_space_type)
     {
 
         //Make environment
         make_env(gym_env_id, kwargs);
 
-        //Get state size
-        _state_size = std::get<0>(_gym_module.call_function<unsigned>("state_size"));
+        if(_workers)
+        {
+            //The first worker is kept by the pool for later episodes
+            auto worker = _workers->borrow();
+            if(worker->get_action_space_type() != _action_space_type)
+                throw std::invalid_argument("The action space of " + gym_env_id +
+                                            " is not of the type given to GymDomain");
+            _state_size = worker->get_state_size();
+            _action_space = worker->get_action_space().clone();
+        } else
+        {
+            //Get state size
+            _state_size = std::get<0>(
+                _gym_module->call_function<unsigned>("state_size")
+            );
+
+            //Get action space
+            if(_action_space_type == SpaceType::Box)
+            {
+                auto action_space_tup =
+                    _gym_module->call_function<std::vector<unsigned>,
+                                               std::vector<double>,
+                                               std::vector<double>>("action_space");
+                _action_space = std::make_unique<BoxSpace>(
+                    std::get<0>(action_space_tup),
+                    std::get<1>(action_space_tup),
+                    std::get<2>(action_space_tup)
+                );
+            } else if (_action_space_type == SpaceType::Discrete)
+            {
+                auto action_space_tup = _gym_module->call_function<const unsigned>(
+                    "action_space"
+                );
+                _action_space = std::make_unique<DiscreteSpace>(
+                    std::get<0>(action_space_tup)
+                );
+            }
+        }
 
-        //Get action space
         if(_action_space_type == SpaceType::Box)
         {
-            auto action_space_tup =
-                _gym_module.call_function<std::vector<unsigned>,
-                                          std::vector<double>,
-                                          std::vector<double>>("action_space");
-            _action_space = std::make_unique<BoxSpace>(std::get<0>(action_space_tup),
-                                                       std::get<1>(action_space_tup),
-                                                       std::get<2>(action_space_tup));
-        } else if (_action_space_type == SpaceType::Discrete)
+            const BoxSpace* box_action_space =
+                dynamic_cast<BoxSpace*>(_action_space.get());
+            _action_lows = box_action_space->get_lows();
+            _action_highs = box_action_space->get_highs();
+        }
+
+        //A discrete action is handed over as its index
+        _observation.resize(_state_size);
+        _action.resize(_action_space_type == SpaceType::Discrete ? 1 :
+                       _action_space->get_num_elements());
+        _step_result.resize(2);
+
+        if(_batch_size > 1)
         {
-            auto action_space_tup = _gym_module.call_function<const unsigned>(
-                "action_space"
-            );
-            _action_space = std::make_unique<DiscreteSpace>(
-                std::get<0>(action_space_tup)
-            );
+            _batch_observations.resize(_batch_size * _state_size);
+            _batch_actions.resize(_batch_size * _action.size());
+            _batch_rewards.resize(_batch_size);
+            _batch_dones.resize(_batch_size);
+            _batch_seeds.resize(_batch_size);
         }
 
     }
 
+    //The environment is given by env_id, which can be "module:Class" for an
+    //environment outside of gym, such as "stand_in_env:StandInEnv", and
+    //action_space, which is either "Discrete" or "Box"
+    GymDomain(const JSON& json) :
+        GymDomain(json.get<std::string>({"env_id"}),
+                  action_space_type(json.get<std::string>({"action_space"})),
+                  make_kwargs(json),
+                  json.value({"completion_fitness"}, 1e6),
+                  json.value({"render"}, false),
+                  json.value({"trace"}, false),
+                  json.optional_value<unsigned>({"seed"}),
+                  json.value({"worker_processes"}, false),
+                  json.value({"batch_size"}, 1u)) {}
+
     ~GymDomain() = default;
 
     GymDomain(const GymDomain& gym_domain) :
         Domain<G, double>(gym_domain._domain_trace, gym_domain._completion_fitness,
                           gym_domain._seed, gym_domain._render),
         _kwargs(gym_domain._kwargs),
+        _gym_env_id(gym_domain._gym_env_id),
         _gym_module(gym_domain._gym_module),
+        _workers(gym_domain._workers),
+        _batch_size(gym_domain._batch_size),
         _state_size(gym_domain._state_size),
         _action_space_type(gym_domain._action_space_type),
         _action_space(gym_domain._action_space ?
-		      gym_domain._action_space->clone() : nullptr) {}
+		      gym_domain._action_space->clone() : nullptr),
+        _action_lows(gym_domain._action_lows),
+        _action_highs(gym_domain._action_highs),
+        _observation(gym_domain._observation),
+        _action(gym_domain._action),
+        _step_result(gym_domain._step_result),
+        _batch_observations(gym_domain._batch_observations),
+        _batch_actions(gym_domain._batch_actions),
+        _batch_rewards(gym_domain._batch_rewards),
+        _batch_dones(gym_domain._batch_dones),
+        _batch_seeds(gym_domain._batch_seeds) {}
 
     GymDomain(GymDomain&& gym_domain) = default;
 
     GymDomain& operator=(const GymDomain& gym_domain)
     {
         _kwargs = gym_domain._kwargs;
+        _gym_env_id = gym_domain._gym_env_id;
         _gym_module = gym_domain._gym_module;
+        _workers = gym_domain._workers;
+        _batch_size = gym_domain._batch_size;
         _state_size = gym_domain._state_size;
         _action_space_type = gym_domain._action_space_type;
 	if(gym_domain._action_space)
             _action_space = gym_domain._action_space->clone();
 	else
 	    _action_space = nullptr;
+        _action_lows = gym_domain._action_lows;
+        _action_highs = gym_domain._action_highs;
+        _observation = gym_domain._observation;
+        _action = gym_domain._action;
+        _step_result = gym_domain._step_result;
+        _batch_observations = gym_domain._batch_observations;
+        _batch_actions = gym_domain._batch_actions;
+        _batch_rewards = gym_domain._batch_rewards;
+        _batch_dones = gym_domain._batch_dones;
+        _batch_seeds = gym_domain._batch_seeds;
+        return *this;
     }
 
     GymDomain& operator=(GymDomain&& gym_domain) = default;
 
+    //Runs the episodes of every organism and trial _batch_size at a time, so a
+    //whole batch advances with one call into Python or one message to a worker.
+    //Each episode is controlled by its own copy of its organism's phenotype, so
+    //a network with state starts every trial afresh, and its environment is
+    //seeded with the seed of its trial, as it is when the trials are run one at
+    //a time.
+    using Domain<G, double>::evaluate_trials;
+
+    std::vector<double> evaluate_trials(Population<G, double>& pop,
+                                        const std::vector<unsigned>& trial_seeds,
+                                        const std::size_t first_org,
+                                        const std::size_t last_org,
+                                        const std::size_t first_trial,
+                                        const std::size_t last_trial) override
+    {
+        //Tracing and recording trajectories follow one episode at a time
+        if(_batch_size <= 1 || this->_domain_trace || this->recording_trajectories())
+            return Domain<G, double>::evaluate_trials(pop, trial_seeds, first_org,
+                                                      last_org, first_trial,
+                                                      last_trial);
+
+        const std::size_t num_trials = last_trial - first_trial;
+        const std::size_t num_episodes = (last_org - first_org) * num_trials;
+
+        std::vector<std::unique_ptr<Phenotype<double>>> phenotypes;
+        phenotypes.reserve(num_episodes);
+        for(std::size_t i = first_org; i < last_org; i++)
+        {
+            Organism<G, double>& org = pop.get_mutable_organism(i);
+            org.genesis();
+            for(std::size_t j = 0; j < num_trials; j++)
+                phenotypes.push_back(org.get_phenotype().clone_phenotype());
+        }
+
+        const std::vector<unsigned> range_seeds(trial_seeds.begin() + first_trial,
+                                                trial_seeds.begin() + last_trial);
+
+        if(!_workers)
+            return run_batches(phenotypes, range_seeds, nullptr);
+
+        //The batch of environments in a worker is only stepped by one domain
+        //at a time
+        auto worker = _workers->borrow();
+        return run_batches(phenotypes, range_seeds, &*worker);
+    }
+
 protected:
 
     void make_env(const std::string gym_env_id,
-                  const std::optional<const GymMakeKwargs>& kwargs = std::nullopt) const
+                  const std::optional<const GymMakeKwargs>& kwargs = std::nullopt)
     {
 
+        //Workers are started as they are needed, each making its own environment
+        if(!_gym_module)
+        {
+            const auto kwarg_map = kwargs.has_value() ? kwargs->get_kwargs() :
+                std::map<const std::string, const double>();
+            const unsigned batch_size = _batch_size;
+            _workers = std::make_shared<ClonePool<GymWorker>>(
+                [gym_env_id, kwarg_map, batch_size]()
+                {
+                    auto worker = std::make_unique<GymWorker>(gym_env_id, kwarg_map);
+                    if(batch_size > 1)
+                        worker->make_envs(batch_size);
+                    return worker;
+                });
+            return;
+        }
+
         if(kwargs.has_value())
-            _gym_module.call_function("make_env", gym_env_id, kwargs->get_kwargs());
+            _gym_module->call_function("make_env", gym_env_id, kwargs->get_kwargs());
         else
-            _gym_module.call_function("make_env", gym_env_id);
+            _gym_module->call_function("make_env", gym_env_id);
+
+        if(_batch_size > 1)
+        {
+            if(kwargs.has_value())
+                _gym_module->call_function("make_envs", gym_env_id, _batch_size,
+                                           kwargs->get_kwargs());
+            else
+                _gym_module->call_function("make_envs", gym_env_id, _batch_size);
+        }
 
     }
 
-    void close_env() const
+    void close_env()
     {
-        _gym_module.call_function("close");
+        if(_gym_module)
+            _gym_module->call_function("close");
+        else
+            _workers.reset();
     }
 
+    //Every episode also seeds its environment with its trial seed when it is
+    //reset
     void seed_env() const
     {
         //Seed
-        if(this->_seed.has_value())
-            _gym_module.call_function("seed", this->_seed.value());
+        if(_gym_module && this->_seed.has_value())
+            _gym_module->call_function("seed", this->_seed.value());
     }
 
     std::optional<GymMakeKwargs> _kwargs;
+    std::string _gym_env_id;
 
 private:
 
+    static SpaceType action_space_type(const std::string& name)
+    {
+        if(name == "Discrete")
+            return SpaceType::Discrete;
+        if(name == "Box")
+            return SpaceType::Box;
+        throw std::invalid_argument("Unknown gym action space " + name);
+    }
+
+    static std::optional<GymMakeKwargs> make_kwargs(const JSON& json)
+    {
+        const auto kwarg_map =
+            json.optional_value<std::map<std::string, double>>({"kwargs"});
+        if(!kwarg_map.has_value())
+            return std::nullopt;
+
+        GymMakeKwargs kwargs;
+        for(const auto& kwarg : *kwarg_map)
+            kwargs.set_kwarg(kwarg.first, kwarg.second);
+        return kwargs;
+    }
+
     PythonModule initialise_gym_module()
     {
         std::stringstream gym_dir;
@@ -162,31 +358,33 @@ private:
         return gym_module;
     }
 
+    //The environment is seeded with rand_seed, so every organism is run on
+    //the same trials
     double single_run(Organism<G, double>& org, unsigned rand_seed) override
     {
+        if(!_workers)
+            return run_episode(org, rand_seed, nullptr);
 
-        auto pheno_net = dynamic_cast<const NetworkBase*>(&org.get_phenotype());
-        if(!pheno_net)
-            throw std::runtime_error("Cannot cast phenotype to NetworkBase in GymDomain"
-                " single_run");
-        const auto final_layer_activ_func = pheno_net->get_final_layer_activ_func();
+        auto worker = _workers->borrow();
+        return run_episode(org, rand_seed, &*worker);
+    }
 
-        //Check final layer activation function is bounded on both sides
-        if(!(final_layer_activ_func->get_lower_bound().has_value() &&
-             final_layer_activ_func->get_upper_bound().has_value()))
-            throw std::runtime_error("The activation function for the final "
-                "layer of the control network for the gym domains must be "
-                "asymtoted on both sides");
+    //Runs an episode in worker, or in the embedded environment if worker is null
+    double run_episode(Organism<G, double>& org, const unsigned rand_seed,
+                       GymWorker* worker)
+    {
+
+        const std::pair<double, double> out_bounds = output_bounds(org.get_phenotype());
 
         double reward = 0.;
         bool done = false;
 
-        std::vector<double> state = reset_env();
+        reset_env(rand_seed, worker);
 
         if(this->_domain_trace)
         {
             std::cout << "State: ";
-            for(const auto s : state)
+            for(const auto s : _observation)
                 std::cout << s << " ";
             std::cout << std::endl;
         }
@@ -195,7 +393,9 @@ private:
         {
 
             //Activate control network
-            const std::vector<double> net_outs = org.get_phenotype().activate(state);
+            const std::vector<double> net_outs = org.get_phenotype().activate(
+                _observation
+            );
 
             if(this->_domain_trace)
             {
@@ -205,58 +405,32 @@ private:
                 std::cout << std::endl;
             }
 
-            StepReturn step_return;
-
-            //If action space is discrete, choose maximum net output index as action
-            if(_action_space_type == SpaceType::Discrete)
-            {
-                const unsigned max_action =
-                    std::max_element(net_outs.begin(), net_outs.end())
-                    - net_outs.begin();
-
-                if(this->_domain_trace)
-                    std::cout << "Max action: " << max_action << std::endl;
+            set_action(net_outs, out_bounds, _action.data());
 
-                step_return = step(max_action);
-
-            //If action space is box, scale the network outputs to the min and max
-            //value that the action can take
-            } else if(_action_space_type == SpaceType::Box)
+            if(this->_domain_trace)
             {
-                //Cast Space to BoxSpace
-                const BoxSpace* box_action_space =
-                    dynamic_cast<BoxSpace*>(_action_space.get());
-
-                //Scale net outputs correctly for action space
-                std::vector<double> action_vals(net_outs.size());
-                for(std::size_t i = 0; i < net_outs.size(); i++)
-                    action_vals[i] = normalise(
-                        net_outs[i],
-                        final_layer_activ_func->get_lower_bound().get_value(),
-                        final_layer_activ_func->get_upper_bound().get_value(),
-                        box_action_space->get_lows()[i],
-                        box_action_space->get_highs()[i]);
-
-                if(this->_domain_trace)
+                if(_action_space_type == SpaceType::Discrete)
+                    std::cout << "Max action: " << _action[0] << std::endl;
+                else
                 {
                     std::cout << "action_vals: ";
-                    for(auto v : action_vals)
+                    for(auto v : _action)
                         std::cout << v << " ";
                     std::cout << std::endl;
                 }
+            }
 
-                //const std::vector<double> action_vals = net_outs;
+            this->record_step(_observation, _action);
 
-                step_return = step(action_vals);
-            }
+            const StepReturn step_return = step(worker);
 
-            state = step_return.state;
             reward += step_return.reward;
+            this->record_reward(step_return.reward);
             done = step_return.done;
 
             if(this->_domain_trace)
             {
-                step_return.print();
+                step_return.print(_observation);
                 std::cout << "Total reward: " << reward << std::endl;
             }
 
@@ -268,18 +442,71 @@ private:
         return reward;
     }
 
-    std::vector<double> reset_env() const
+    //Lower and upper bound of the network outputs, which box actions are
+    //scaled from
+    std::pair<double, double> output_bounds(const Phenotype<double>& phenotype) const
+    {
+        auto pheno_net = dynamic_cast<const NetworkBase*>(&phenotype);
+        if(!pheno_net)
+            throw std::runtime_error("Cannot cast phenotype to NetworkBase in GymDomain"
+                " single_run");
+        const auto final_layer_activ_func = pheno_net->get_final_layer_activ_func();
+
+        //Check final layer activation function is bounded on both sides
+        if(!(final_layer_activ_func->get_lower_bound().has_value() &&
+             final_layer_activ_func->get_upper_bound().has_value()))
+            throw std::runtime_error("The activation function for the final "
+                "layer of the control network for the gym domains must be "
+                "asymtoted on both sides");
+
+        return {final_layer_activ_func->get_lower_bound().get_value(),
+                final_layer_activ_func->get_upper_bound().get_value()};
+    }
+
+    //Writes the action chosen by the network outputs into action
+    void set_action(const std::vector<double>& net_outs,
+                    const std::pair<double, double>& out_bounds, double* action) const
+    {
+        //If action space is discrete, choose maximum net output index as action
+        if(_action_space_type == SpaceType::Discrete)
+            action[0] = std::max_element(net_outs.begin(), net_outs.end())
+                - net_outs.begin();
+
+        //If action space is box, scale the network outputs to the min and max
+        //value that the action can take
+        else if(_action_space_type == SpaceType::Box)
+            for(std::size_t i = 0; i < net_outs.size(); i++)
+                action[i] = normalise(net_outs[i], out_bounds.first, out_bounds.second,
+                                      _action_lows[i], _action_highs[i]);
+    }
+
+    //Seeds the environment with seed and writes its first observation into
+    //_observation
+    //The embedded environment is handed this domain's buffers every episode as
+    //copies of the domain share it
+    void reset_env(const unsigned seed, GymWorker* worker)
     {
-        return std::get<0>(_gym_module.call_function<std::vector<double>>("reset"));
+        if(worker)
+        {
+            worker->reset(seed, _observation.data());
+            return;
+        }
+
+        _gym_module->call_function(
+            "reset",
+            PythonBuffer{_observation.data(), _observation.size()},
+            PythonBuffer{_action.data(), _action.size()},
+            PythonBuffer{_step_result.data(), _step_result.size()},
+            seed
+        );
     }
 
     struct StepReturn
     {
-        std::vector<double> state;
         double reward;
         bool done;
 
-        void print() const
+        void print(const std::vector<double>& state) const
         {
             std::cout << "State: [ ";
             for(std::size_t i = 0; i < state.size(); i++)
@@ -290,14 +517,141 @@ private:
         }
     };
 
-    template <typename A>
-    StepReturn step(const A& action) const
+    //Takes the action in _action and writes the next observation into
+    //_observation
+    StepReturn step(GymWorker* worker)
+    {
+        if(worker)
+        {
+            bool done;
+            const double reward = worker->step(_action.data(), this->_render,
+                                               _observation.data(), done);
+            return StepReturn{reward, done};
+        }
+
+        _gym_module->call_function("step", _action_space_type == SpaceType::Discrete,
+                                   this->_render);
+        return StepReturn{_step_result[0], _step_result[1] != 0.};
+    }
+
+    //Runs an episode for every phenotype, in batches of _batch_size episodes,
+    //in worker or in the embedded environments if worker is null
+    //The phenotypes run every trial of an organism in turn and episode i is
+    //seeded with the seed of trial i % num_trials
+    std::vector<double> run_batches(
+        const std::vector<std::unique_ptr<Phenotype<double>>>& phenotypes,
+        const std::vector<unsigned>& trial_seeds, GymWorker* worker)
+    {
+        const std::size_t num_episodes = phenotypes.size();
+        const std::pair<double, double> out_bounds = output_bounds(*phenotypes.front());
+
+        std::vector<double> fitnesses(num_episodes, 0.);
+        std::vector<double> observation(_state_size);
+
+        for(std::size_t first = 0; first < num_episodes; first += _batch_size)
+        {
+            const std::size_t num_running =
+                std::min<std::size_t>(_batch_size, num_episodes - first);
+
+            //The environments past the last episode are marked as done so
+            //they are left alone
+            for(std::size_t i = 0; i < _batch_size; i++)
+            {
+                _batch_dones[i] = i < num_running ? 0. : 1.;
+                _batch_seeds[i] = trial_seeds[(first + i) % trial_seeds.size()];
+            }
+
+            reset_batch(worker);
+
+            while(std::any_of(_batch_dones.begin(), _batch_dones.end(),
+                              [](const double done) { return done == 0.; }))
+            {
+                for(std::size_t i = 0; i < num_running; i++)
+                {
+                    if(_batch_dones[i] != 0.)
+                        continue;
+
+                    std::copy_n(_batch_observations.begin() + i * _state_size,
+                                _state_size, observation.begin());
+                    const std::vector<double> net_outs =
+                        phenotypes[first + i]->activate(observation);
+                    set_action(net_outs, out_bounds,
+                               _batch_actions.data() + i * _action.size());
+                }
+
+                //Environments that are already done are given a reward of 0
+                step_batch(worker);
+
+                for(std::size_t i = 0; i < num_running; i++)
+                    fitnesses[first + i] += _batch_rewards[i];
+            }
+        }
+
+        return fitnesses;
+    }
+
+    //Resets the environments of the batch that are not done, after seeding
+    //each with its seed in _batch_seeds
+    void reset_batch(GymWorker* worker)
     {
-        auto step_return = _gym_module.call_function<std::vector<double>, double, bool>
-            ("step", action, this->_render);
-        return StepReturn{std::get<0>(step_return),
-                          std::get<1>(step_return),
-                          std::get<2>(step_return)};
+        if(worker)
+        {
+            worker->reset_batch(_batch_seeds.data(), _batch_dones.data(),
+                                _batch_observations.data());
+            return;
+        }
+
+        _gym_module->call_function(
+            "reset_batch",
+            PythonBuffer{_batch_observations.data(), _batch_observations.size()},
+            PythonBuffer{_batch_actions.data(), _batch_actions.size()},
+            PythonBuffer{_batch_rewards.data(), _batch_rewards.size()},
+            PythonBuffer{_batch_dones.data(), _batch_dones.size()},
+            _batch_seeds
+        );
+    }
+
+    //Steps every environment of the batch that is not done with its action in
+    //_batch_actions
+    void step_batch(GymWorker* worker)
+    {
+        if(worker)
+        {
+            worker->step_batch(_batch_actions.data(), this->_render,
+                               _batch_observations.data(), _batch_rewards.data(),
+                               _batch_dones.data());
+            return;
+        }
+
+        _gym_module->call_function("step_batch",
+                                   _action_space_type == SpaceType::Discrete,
+                                   this->_render);
+    }
+
+    JSON to_json_impl() const override
+    {
+        JSON json;
+        json.emplace("name", "GymDomain");
+        json.emplace("env_id", _gym_env_id);
+        json.emplace("action_space",
+                     _action_space_type == SpaceType::Discrete ? "Discrete" : "Box");
+        if(_kwargs.has_value())
+        {
+            JSON kwargs;
+            for(const auto& kwarg : _kwargs->get_kwargs())
+                kwargs.emplace(kwarg.first, kwarg.second);
+            json.emplace("kwargs", kwargs);
+        }
+        json.emplace("completion_fitness", this->_completion_fitness);
+        json.emplace("render", this->_render);
+        json.emplace("worker_processes", !_gym_module.has_value());
+        json.emplace("batch_size", _batch_size);
+        return json;
+    }
+
+    GymDomain<G>* clone_impl() const override
+    {
+        return new GymDomain<G>(*this);
     }
 
     bool check_phenotype_spec(const PhenotypeSpec& pheno_spec) const override
@@ -335,22 +689,46 @@ private:
 
     void render() override {}
 
-    void trial_reset(const unsigned trial_num) override {}
-
-    void org_reset() override
+    void exp_run_reset_impl(const unsigned, const std::optional<unsigned>&) override
     {
         seed_env();
     }
 
-    PythonModule _gym_module;
+    void trial_reset(const unsigned) override {}
+
+    //Only one of these is used
+    std::optional<PythonModule> _gym_module;
+    std::shared_ptr<ClonePool<GymWorker>> _workers;
+
+    //Number of environments stepped together by evaluate_trials
+    unsigned _batch_size;
 
     unsigned _state_size;
 
     const SpaceType _action_space_type;
     std::unique_ptr<Space> _action_space;
+    std::vector<double> _action_lows;
+    std::vector<double> _action_highs;
+
+    //Viewed in place by the Python side
+    std::vector<double> _observation;
+    std::vector<double> _action;
+    //Reward and whether the episode is done
+    std::vector<double> _step_result;
+
+    //Values of every environment of the batch one after the other, viewed in
+    //place by the Python side like the buffers above
+    std::vector<double> _batch_observations;
+    std::vector<double> _batch_actions;
+    std::vector<double> _batch_rewards;
+    std::vector<double> _batch_dones;
+    std::vector<unsigned> _batch_seeds;
 
 };
 
+static Factory<Domain<double, double>>::Registrar gym_domain_registrar("GymDomain",
+    [](const JSON& json) {return std::make_shared<GymDomain<double>>(json);});
+
 } // namespace NeuroEvo
 
 #endif
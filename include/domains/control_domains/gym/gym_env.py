@@ -1,56 +1,130 @@
-import gym
-from gym.spaces import Discrete, Box
+import importlib
+
+try:
+    import gym
+except ImportError:
+    gym = None
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+#An env_id of the form "module:Class" constructs Class from module instead of
+#going through gym.make, so any env following the gym API can be used
+def _make(env_id, **kwargs):
+    if ':' in env_id:
+        module_name, class_name = env_id.split(':')
+        return getattr(importlib.import_module(module_name), class_name)(**kwargs)
+    return gym.make(env_id, **kwargs)
 
 def make_env(env_id, **kwargs):
     global env
-    env = gym.make(env_id, **kwargs)
+    env = _make(env_id, **kwargs)
+
+#The observation, action and step result (reward and done) buffers are owned
+#by C++ and handed over as memoryviews, so writing into them here is seen
+#directly on the C++ side without converting any lists
+def _view(buffer):
+    if np is not None:
+        return np.frombuffer(buffer, dtype=np.float64)
+    return buffer.cast('d')
+
+def _write(view, values):
+    if np is not None:
+        view[:] = values
+    else:
+        for i, v in enumerate(values):
+            view[i] = v
 
-def reset():
-    init_state = env.reset()
-    return init_state.tolist()
+def reset(observation, action, result, seed):
+    global obs_view, action_view, result_view
+    obs_view = _view(observation)
+    action_view = _view(action)
+    result_view = _view(result)
+    env.seed(seed)
+    _write(obs_view, env.reset())
 
-def step(action, render):
+def _action(view, discrete):
+    if discrete:
+        return int(view[0])
+    elif np is not None:
+        return view.copy()
+    else:
+        return list(view)
+
+def step(discrete, render):
 
     if render:
         env.render()
-    s, r, done, info = env.step(action)
 
-    #Convert numpy array to list
-    s = s.tolist()
+    s, r, done, info = env.step(_action(action_view, discrete))
+
+    _write(obs_view, s)
+    result_view[0] = r
+    result_view[1] = 1. if done else 0.
+
+#A batch of environments that is stepped in one call. The buffers hold the
+#observations, actions, rewards and done flags of every environment one after
+#the other. Environments that are done are not reset or stepped and are given
+#a reward of 0, which is how the C++ side leaves environments of the batch
+#unused.
+def make_envs(env_id, num_envs, **kwargs):
+    global envs
+    envs = [_make(env_id, **kwargs) for _ in range(num_envs)]
+
+def reset_batch(observations, actions, rewards, dones, seeds):
+    global batch_obs_view, batch_action_view, batch_reward_view, batch_done_view
+    batch_obs_view = _view(observations)
+    batch_action_view = _view(actions)
+    batch_reward_view = _view(rewards)
+    batch_done_view = _view(dones)
 
-    '''
-    print("Python action:", action)
-    print("Python render:", render)
-    print("Python s:", s)
-    print("Python r:", r)
-    print("Python info:", info)
-    print("Python done:", done)
-    '''
+    state_size = len(batch_obs_view) // len(envs)
+    for i, e in enumerate(envs):
+        if batch_done_view[i] == 0.:
+            e.seed(seeds[i])
+            _write(batch_obs_view[i * state_size:(i + 1) * state_size], e.reset())
 
-    return s, r, done
+def step_batch(discrete, render):
+
+    state_size = len(batch_obs_view) // len(envs)
+    action_size = len(batch_action_view) // len(envs)
+
+    for i, e in enumerate(envs):
+
+        if batch_done_view[i] != 0.:
+            batch_reward_view[i] = 0.
+            continue
+
+        if render:
+            e.render()
+
+        action = batch_action_view[i * action_size:(i + 1) * action_size]
+        s, r, done, info = e.step(_action(action, discrete))
+
+        _write(batch_obs_view[i * state_size:(i + 1) * state_size], s)
+        batch_reward_view[i] = r
+        batch_done_view[i] = 1. if done else 0.
 
 def close():
     env.close()
+    for e in globals().get('envs', []):
+        e.close()
 
+#Discrete spaces have n actions, box spaces have a shape and bounds
 def action_space():
-    if isinstance(env.action_space, Discrete):
+    if hasattr(env.action_space, 'n'):
         return env.action_space.n
-    if isinstance(env.action_space, Box):
+    else:
         #These might not always be easily converted to lists if they are
         #multi-dimensional arrays
-        return list(env.action_space.shape), env.action_space.low.tolist(), env.action_space.high.tolist()
+        return (list(env.action_space.shape),
+                [float(v) for v in env.action_space.low],
+                [float(v) for v in env.action_space.high])
 
 def state_size():
     return env.observation_space.shape[0]
 
 def seed(seed_val):
     env.seed(seed_val)
-
-'''
-make_env('CartPole-v0', gravity=8.7)
-init_state = reset()
-step_state = step(1, False)
-
-print("Init state:", init_state)
-print("Step state:", step_state)
-'''
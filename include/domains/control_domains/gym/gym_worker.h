@@ -0,0 +1,105 @@
+#ifndef _GYM_WORKER_H_
+#define _GYM_WORKER_H_
+
+/*
+ * An environment running in its own Python process (gym_worker.py), talked to
+ * over a pair of pipes in a compact binary protocol. Every worker has its own
+ * interpreter and environment, so workers can step environments in parallel
+ * where an environment in the embedded interpreter is held by the GIL and
+ * shared by every copy of a domain.
+ */
+
+#include <domains/control_domains/gym/space.h>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace NeuroEvo {
+
+class GymWorker
+{
+
+public:
+
+    //Starts a worker process and makes the environment in it
+    GymWorker(const std::string& gym_env_id,
+              const std::map<const std::string, const double>& kwargs =
+                  std::map<const std::string, const double>());
+
+    GymWorker(const GymWorker&) = delete;
+    GymWorker& operator=(const GymWorker&) = delete;
+
+    //Closes the environment and waits for the process to finish
+    ~GymWorker();
+
+    unsigned get_state_size() const;
+    SpaceType get_action_space_type() const;
+    const Space& get_action_space() const;
+
+    void seed(const unsigned seed);
+
+    //Seeds the environment with seed and writes its first observation into
+    //observation
+    void reset(const unsigned seed, double* observation);
+
+    //Takes action, which holds the index of a discrete action or every element
+    //of a box action, writes the next observation into observation and returns
+    //the reward
+    double step(const double* action, const bool render, double* observation,
+                bool& done);
+
+    //Makes num_envs environments in the worker that are reset and stepped
+    //together in one message each
+    void make_envs(const unsigned num_envs);
+    unsigned get_num_envs() const;
+
+    //The batch buffers hold the values of every environment one after the
+    //other. Environments whose entry in dones is not 0 are left as they are,
+    //the others are seeded with their entry in seeds and reset.
+    void reset_batch(const unsigned* seeds, const double* dones,
+                     double* observations);
+
+    //Steps every environment whose entry in dones is 0 with its action, and
+    //writes its next observation, reward and whether it is done
+    void step_batch(const double* actions, const bool render, double* observations,
+                    double* rewards, double* dones);
+
+private:
+
+    void make_env(const std::string& gym_env_id,
+                  const std::map<const std::string, const double>& kwargs);
+
+    void send(const void* data, const std::size_t size);
+    void receive(void* data, const std::size_t size);
+
+    template <typename T>
+    T receive()
+    {
+        T value;
+        receive(&value, sizeof(T));
+        return value;
+    }
+
+    pid_t _pid;
+    int _commands;
+    int _replies;
+
+    unsigned _state_size;
+    SpaceType _action_space_type;
+    std::unique_ptr<Space> _action_space;
+    unsigned _action_size;
+
+    std::vector<char> _step_command;
+    std::vector<char> _step_reply;
+
+    unsigned _num_envs;
+    std::vector<char> _batch_command;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
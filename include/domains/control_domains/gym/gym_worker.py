@@ -0,0 +1,152 @@
+'''
+Runs one environment in its own process on behalf of a GymWorker in C++.
+Commands arrive on stdin and replies leave on stdout in a compact binary
+protocol of native byte order values:
+
+    M  make   u32 id length, id, u32 num kwargs, (u32 name length, name, f64)...
+              -> u32 state size, u8 discrete,
+                 u32 n                                  if discrete
+                 u32 dims, u32 shape..., f64 lows..., f64 highs...   otherwise
+    S  seed   u32 seed
+    R  reset  u32 seed -> f64 observation...
+    T  step   u8 render, f64 action...
+              -> f64 observation..., f64 reward, u8 done
+    B  make batch   u32 num envs     (of the environment made by M)
+    Q  reset batch  u32 seed..., f64 done...
+                    -> f64 observation...
+    V  step batch   u8 render, f64 done..., f64 action...
+                    -> f64 observation..., f64 reward..., f64 done...
+    C  close
+
+The batch commands carry the values of every environment of the batch one
+after the other, and leave the environments that are done untouched.
+'''
+
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import gym_env
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+def read(stream, fmt):
+    size = struct.calcsize(fmt)
+    data = stream.read(size)
+    if len(data) != size:
+        sys.exit(0)
+    return struct.unpack(fmt, data)
+
+def read_string(stream):
+    length, = read(stream, '=I')
+    return stream.read(length).decode()
+
+def main():
+
+    commands = sys.stdin.buffer
+    replies = os.fdopen(os.dup(1), 'wb')
+    #Anything the environment prints goes to stderr rather than into the replies
+    os.dup2(2, 1)
+
+    state_size = 0
+    discrete = True
+    action_size = 1
+    num_envs = 0
+
+    while True:
+
+        command = commands.read(1)
+
+        if command == b'M':
+            env_id = read_string(commands)
+            num_kwargs, = read(commands, '=I')
+            kwargs = {}
+            for _ in range(num_kwargs):
+                name = read_string(commands)
+                kwargs[name], = read(commands, '=d')
+
+            make_kwargs = kwargs
+            gym_env.make_env(env_id, **kwargs)
+            env = gym_env.env
+
+            state_size = env.observation_space.shape[0]
+            discrete = hasattr(env.action_space, 'n')
+            reply = struct.pack('=IB', state_size, discrete)
+            if discrete:
+                action_size = 1
+                reply += struct.pack('=I', env.action_space.n)
+            else:
+                shape = list(env.action_space.shape)
+                lows = [float(v) for v in env.action_space.low]
+                highs = [float(v) for v in env.action_space.high]
+                action_size = len(lows)
+                reply += struct.pack('=I%dI' % len(shape), len(shape), *shape)
+                reply += struct.pack('=%dd' % action_size, *lows)
+                reply += struct.pack('=%dd' % action_size, *highs)
+
+        elif command == b'S':
+            seed, = read(commands, '=I')
+            gym_env.seed(seed)
+            continue
+
+        elif command == b'R':
+            seed, = read(commands, '=I')
+            gym_env.seed(seed)
+            reply = struct.pack('=%dd' % state_size, *gym_env.env.reset())
+
+        elif command == b'T':
+            render, = read(commands, '=B')
+            action = read(commands, '=%dd' % action_size)
+            if discrete:
+                action = int(action[0])
+            elif np is not None:
+                action = np.array(action)
+            else:
+                action = list(action)
+
+            if render:
+                gym_env.env.render()
+            s, r, done, info = gym_env.env.step(action)
+
+            reply = struct.pack('=%dddB' % state_size, *s, r, bool(done))
+
+        elif command == b'B':
+            num_envs, = read(commands, '=I')
+            gym_env.make_envs(env_id, num_envs, **make_kwargs)
+            observations = bytearray(num_envs * state_size * 8)
+            actions = bytearray(num_envs * action_size * 8)
+            rewards = bytearray(num_envs * 8)
+            dones = bytearray(num_envs * 8)
+            continue
+
+        elif command == b'Q':
+            seeds = read(commands, '=%dI' % num_envs)
+            dones[:] = commands.read(len(dones))
+            gym_env.reset_batch(memoryview(observations), memoryview(actions),
+                                memoryview(rewards), memoryview(dones), seeds)
+            reply = bytes(observations)
+
+        elif command == b'V':
+            render, = read(commands, '=B')
+            dones[:] = commands.read(len(dones))
+            actions[:] = commands.read(len(actions))
+            gym_env.step_batch(discrete, bool(render))
+            reply = bytes(observations) + bytes(rewards) + bytes(dones)
+
+        else:
+            #Close, or the C++ side has gone
+            break
+
+        replies.write(reply)
+        replies.flush()
+
+    if hasattr(gym_env, 'env'):
+        gym_env.close()
+
+if __name__ == '__main__':
+    main()
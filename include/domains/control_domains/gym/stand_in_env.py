@@ -0,0 +1,77 @@
+'''
+A small environment that follows the gym API without needing gym, for trying
+out GymDomain, its worker processes and its batches. It is made with the
+env_id "stand_in_env:StandInEnv".
+
+An agent on a line has to reach a target. The observation is the position of
+the agent, its velocity and the position of the target, and every step is
+rewarded with minus the distance to the target. The start and the target are
+drawn from the seed given to seed(), so identically seeded environments run
+identical episodes. The episode is done when the agent is at the target or
+after max_steps steps.
+
+The actions are pushes left or right, or a push in [-1, 1] when continuous is
+not 0.
+'''
+
+import random
+
+
+class Discrete:
+
+    def __init__(self, n):
+        self.n = n
+
+
+class Box:
+
+    def __init__(self, low, high):
+        self.low = low
+        self.high = high
+        self.shape = (len(low),)
+
+
+class StandInEnv:
+
+    def __init__(self, continuous=0., max_steps=50.):
+        self.continuous = continuous != 0.
+        self.max_steps = int(max_steps)
+        self.action_space = Box([-1.], [1.]) if self.continuous else Discrete(2)
+        self.observation_space = Box([-10., -1., -10.], [10., 1., 10.])
+        self.rng = random.Random()
+
+    def seed(self, seed=None):
+        self.rng.seed(seed)
+        return [seed]
+
+    def reset(self):
+        self.x = self.rng.uniform(-5., 5.)
+        self.target = self.rng.uniform(-5., 5.)
+        self.v = 0.
+        self.t = 0
+        return self._observation()
+
+    def step(self, action):
+
+        if self.continuous:
+            push = min(max(float(action[0]), -1.), 1.)
+        else:
+            push = 1. if action == 1 else -1.
+
+        self.v = min(max(0.9 * self.v + 0.1 * push, -1.), 1.)
+        self.x = min(max(self.x + self.v, -10.), 10.)
+        self.t += 1
+
+        distance = abs(self.x - self.target)
+        done = distance < 0.1 or self.t >= self.max_steps
+
+        return self._observation(), -distance, done, {}
+
+    def render(self, mode='human'):
+        print('x: %.3f target: %.3f' % (self.x, self.target))
+
+    def close(self):
+        pass
+
+    def _observation(self):
+        return [self.x, self.v, self.target]
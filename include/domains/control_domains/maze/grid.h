@@ -1,60 +1,97 @@
 #ifndef _GRID_H_
 #define _GRID_H_
 
-#include <vector>
+/*
+ * The layout of a maze, read from a .mz file, which holds a grid of square
+ * types (0 for empty, 1 for a wall) followed by a grid of rewards, each
+ * preceded by an empty line.
+ * The squares are stored in a flat array, row by row, and are referred to by
+ * their index, so the agent moves by looking up the square an action takes it
+ * to and senses by looking up the observation of its square, both of which are
+ * worked out when the grid is read.
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace NeuroEvo {
 
-//Set up the 2d grid structure of any maze
-class Grid {
+class Grid
+{
 
 public:
 
-    Grid(const std::string file_name, const unsigned agent_start_x, const unsigned agent_start_y);
+    //The 3x3 neighbourhood of a square
+    static constexpr unsigned OBSERVATION_SIZE = 9;
 
-    void move_agent(const unsigned X, const unsigned Y);
-    void move_reward(const unsigned X, const unsigned Y);
+    //Up, down, left and right
+    static constexpr unsigned NUM_ACTIONS = 4;
 
-    int get_square_type(const unsigned X, const unsigned Y);
-    int get_reward(const unsigned X, const unsigned Y);
-    unsigned get_agent_x() {return _agent_x;};
-    unsigned get_agent_y() {return _agent_y;};
-    unsigned get_height() {return _height;};
-    unsigned get_width() {return _width;};
+    //Distance of a square from which no reward can be reached
+    static constexpr unsigned UNREACHABLE = std::numeric_limits<unsigned>::max();
 
-    void print_grid();
+    Grid(const std::string& file_name);
 
-private:
+    unsigned get_width() const;
+    unsigned get_height() const;
+    unsigned get_num_squares() const;
+
+    unsigned square(const unsigned x, const unsigned y) const
+    {
+        return y * _width + x;
+    }
+
+    bool is_wall(const unsigned square) const
+    {
+        return _walls[square];
+    }
 
-    struct GridSquare {
+    //The rewards of the squares in the file
+    const std::vector<int>& get_rewards() const;
 
-        unsigned int x;
-        unsigned int y;
+    //The neighbourhood of square row by row, 1 for a wall and 0 otherwise.
+    //Squares off the edge of the grid are walls.
+    const double* get_observation(const unsigned square) const
+    {
+        return _observations.data() + square * OBSERVATION_SIZE;
+    }
 
-        /*
-        0 = empty
-        1 = wall
-        */
-        int square_type;
+    //The square taking action from square leads to, which is square itself if
+    //the way is blocked
+    unsigned get_move(const unsigned square, const unsigned action) const
+    {
+        return _moves[square * NUM_ACTIONS + action];
+    }
 
-        int reward;
+    //The number of moves from every square to the nearest square with a
+    //positive reward, found by a breadth first search out from the rewards
+    std::vector<unsigned> distance_field(const std::vector<int>& rewards) const;
 
-    };
+    //Draws the walls, rewards and the agent
+    void print(std::ostream& os, const unsigned agent_square,
+               const std::vector<int>& rewards) const;
 
-    void build_grid(const std::string file_name);
-    std::vector<std::vector<int> > read_grid(const std::string file_name, const unsigned grid_num);
+    const std::string& get_file_name() const;
 
-    std::vector<std::vector<GridSquare> > _squares;
+private:
+
+    void read_grid(const std::string& file_name);
+    void build_observations();
+    void build_moves();
 
     const std::string _file_name;
 
-    unsigned _height;
     unsigned _width;
+    unsigned _height;
+
+    std::vector<uint8_t> _walls;
+    std::vector<int> _rewards;
 
-    //Store agent position so it doesn't have to be searched for all the time
-    unsigned _agent_x;
-    unsigned _agent_y;
+    std::vector<double> _observations;
+    std::vector<unsigned> _moves;
 
 };
 
@@ -4,81 +4,107 @@
 /*
     This maze domain consists of an agent
     trying to locate a reward in a maze.
+    Once the agent has collected enough reward the reward can be switched to
+    another square, so the agent has to find it again.
+    The grid, with the observation and moves of every square, is read once and
+    shared by copies of the domain, so a step of the agent only looks up its
+    square. The rewards can be shaped by the distance to the nearest reward,
+    which is worked out for every square when the domain is made.
 */
 
 #include <domains/domain.h>
 #include <domains/control_domains/maze/grid.h>
-#include <random>
+#include <phenotype/phenotype_specs/network_builder.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <thread>
 
 namespace NeuroEvo {
 
 template <typename G>
-class Maze : public Domain<G> {
+class Maze : public Domain<G, double>
+{
 
 public:
 
-    Maze(const std::string grid_file_name, const bool reward_input, const bool action_input,
-         const bool print_map, const unsigned max_steps = 200) :
-        _grid_file_name(grid_file_name),
-        _max_steps(max_steps),
-        _print_map(print_map),
+    //The reward moves to (switch_x, switch_y) once the total reward is over
+    //switch_total_reward. shaping is the reward for every move that takes the
+    //agent closer to the reward.
+    Maze(const std::string& grid_file_name, const bool reward_input,
+         const bool action_input, const bool domain_trace = false,
+         const unsigned max_steps = 200, const double shaping = 0.,
+         const unsigned agent_start_x = 5, const unsigned agent_start_y = 3,
+         const std::optional<std::pair<unsigned, unsigned>>& switch_square =
+             std::make_pair(9u, 6u),
+         const int switch_total_reward = 20,
+         const double completion_fitness = 120.,
+         const bool render = false) :
+        Domain<G, double>(domain_trace, completion_fitness, std::nullopt, render),
+        _grid(std::make_shared<const Grid>(grid_file_name)),
         _reward_input(reward_input),
         _action_input(action_input),
-        _total_reward(0),
-        _prev_reward(0),
-        _prev_action(std::vector<bool>(4, false)),
-        _agent_init_x(5),
-        _agent_init_y(3),
-        _grid(grid_file_name, _agent_init_x, _agent_init_y),
-        _rng((std::random_device())()),
-        _uni_dist(0, (int)_grid.get_width()-1),
-        Domain<G>(print_map, 120) {}
-
-    bool check_phenotype_spec(PhenotypeSpec<G>& pheno_spec) override {
-
-        Phenotypes::NetworkSpec* network_spec = dynamic_cast<Phenotypes::NetworkSpec*>(&pheno_spec);
+        _max_steps(max_steps),
+        _shaping(shaping),
+        _agent_start_x(agent_start_x),
+        _agent_start_y(agent_start_y),
+        _agent_start(square_in_grid(agent_start_x, agent_start_y)),
+        _switch_square(switch_square),
+        _switch_total_reward(switch_total_reward),
+        _start_rewards(_grid->get_rewards()),
+        _switch_rewards(switched_rewards()),
+        _start_distances(_grid->distance_field(_start_rewards)),
+        _switch_distances(_grid->distance_field(_switch_rewards)),
+        _rewards(_start_rewards),
+        _agent(_agent_start),
+        _inputs(num_inputs()),
+        _outputs(Grid::NUM_ACTIONS) {}
+
+    Maze(const JSON& json) :
+        Maze(json.value({"grid_file"}, std::string(NEURO_EVO_CMAKE_SRC_DIR) +
+                                       "/config/mazes/square_of_squares.mz"),
+             json.value({"reward_input"}, false),
+             json.value({"action_input"}, false),
+             json.value({"trace"}, false),
+             json.value({"max_steps"}, 200u),
+             json.value({"shaping"}, 0.),
+             json.value({"agent_start_x"}, 5u),
+             json.value({"agent_start_y"}, 3u),
+             switch_square_from_json(json),
+             json.value({"switch_total_reward"}, 20),
+             json.value({"completion_fitness"}, 120.),
+             json.value({"render"}, false)) {}
+
+    bool check_phenotype_spec(const PhenotypeSpec& pheno_spec) const override
+    {
+
+        const NetworkBuilder* network_builder =
+            dynamic_cast<const NetworkBuilder*>(&pheno_spec);
 
         //If it is not a network
-        if(network_spec == nullptr) {
-
+        if(network_builder == nullptr)
+        {
             std::cout << "Only network specifications are allowed with" <<
                         " the maze domain!" << std::endl;
             return false;
-
         }
 
         //Check for 4 outputs
-        if(network_spec->num_outputs != 4) {
-
+        if(network_builder->get_num_outputs() != Grid::NUM_ACTIONS)
+        {
             std::cerr << "Number of outputs must be 4 for the maze domain" << std::endl;
             return false;
-
-        }
-
-        //Check inputs
-        if(network_spec->num_inputs != 9 && !_reward_input && !_action_input) {
-
-            std::cerr << "Number of inputs must be 9 if there are no reward or action inputs" 
-                << std::endl;
-            return false;
-
-        }
-
-        if(network_spec->num_inputs != 10 && _reward_input && !_action_input) {
-
-            std::cerr << "Number of inputs must be 10 if there is a reward input but no action" <<
-                " inputs" << std::endl;
-            return false;
-
         }
 
-        if(network_spec->num_inputs != 14 && _reward_input && _action_input) {
-
-            std::cerr << "Number of inputs must be 14 if there are reward and action inputs" << 
-                std::endl;
+        //The neighbourhood, then the previous reward and then the previous action
+        if(network_builder->get_num_inputs() != num_inputs())
+        {
+            std::cerr << "Number of inputs must be " << num_inputs() <<
+                " for the maze domain with " << (_reward_input ? "a" : "no") <<
+                " reward input and " << (_action_input ? "" : "no ") <<
+                "action inputs" << std::endl;
             return false;
-
         }
 
         return true;
@@ -87,254 +113,211 @@ public:
 
 private:
 
-    double single_run(Organism<G>& org, unsigned rand_seed) override {
-
-        _rng = std::mt19937(rand_seed);
-
-        //Randomly place reward and agent
-        //rand_move_reward();
-        //rand_agent_teleport();
-
-        //No need to remake these vectors all the time in move_agent,
-        //so I am just making them here and passing by reference
-
-        //Input size depends on what inputs are provided
-        std::vector<double> inputs(9);
-        if(_reward_input)
-            inputs.resize(inputs.size() + 1);
-        if(_action_input)
-            inputs.resize(inputs.size() + 4);
-
-        std::vector<double> outputs(4);
-        unsigned steps = 0;
-
-        while(++steps < _max_steps) {
-
-            if(_print_map)
-                std::cout << "Steps: " << steps << std::endl;
+    double single_run(Organism<G, double>& org, unsigned) override
+    {
 
-            move_agent(org, inputs, outputs);
+        Phenotype<double>& phenotype = org.get_phenotype();
 
-        }
-
-        double fitness = (double)_total_reward;
-
-        //Reset values
-        _grid.move_agent(_agent_init_x, _agent_init_y);
-        _grid.move_reward(1, 6);
-        _total_reward = 0;
+        //Every trial starts from the squares and rewards in the file
+        _agent = _agent_start;
+        std::copy(_start_rewards.begin(), _start_rewards.end(), _rewards.begin());
+        const std::vector<unsigned>* distances = &_start_distances;
+        bool switched = false;
 
-        return fitness;
-
-    }
+        int total_reward = 0;
+        int prev_reward = 0;
+        std::optional<unsigned> prev_action;
+        double shaped_reward = 0.;
 
-    void move_agent(Organism<G>& org, 
-                    std::vector<double>& inputs, 
-                    std::vector<double>& outputs) {
+        const std::size_t action_inputs_start = Grid::OBSERVATION_SIZE + _reward_input;
 
-        if(_print_map)
-            _grid.print_grid();
+        for(unsigned step = 1; step < _max_steps; step++)
+        {
 
-        //Sense environment
-        auto inputs_bools = sense_environment();
+            if(this->_render)
+                render();
 
-        //Convert to doubles for input to network
-        for(std::size_t i = 0; i < inputs_bools.size(); i++)
-            for(std::size_t j = 0; j < inputs_bools.at(i).size(); j++)
-                inputs.at(i * inputs_bools.at(i).size() + j) = (double)inputs_bools.at(i).at(j);
+            //Sense environment
+            const double* observation = _grid->get_observation(_agent);
+            std::copy(observation, observation + Grid::OBSERVATION_SIZE, _inputs.begin());
 
-        //Add reward input if there is one
-        if(_reward_input && !_action_input)
-            inputs.at(9) = _prev_reward;
+            if(_reward_input)
+                _inputs[Grid::OBSERVATION_SIZE] = prev_reward;
 
-        //Add action input if there is one
-        if(!_reward_input && _action_input) {
-            for(std::size_t i = 0; i < _prev_action.size(); i++)
-                inputs.at(i+9) = (double)_prev_action.at(i);
-        }
+            if(_action_input)
+            {
+                std::fill(_inputs.begin() + action_inputs_start, _inputs.end(), 0.);
+                if(prev_action.has_value())
+                    _inputs[action_inputs_start + *prev_action] = 1.;
+            }
 
-        //Add both inputs if that is the case
-        if(_reward_input && _action_input) {
-            inputs.at(9) = _prev_reward;
-            for(std::size_t i = 0; i < _prev_action.size(); i++)
-                inputs.at(i+10) = (double)_prev_action.at(i);
-        }
+            phenotype.activate_into(_inputs, _outputs);
 
+            const unsigned action = std::max_element(_outputs.begin(), _outputs.end()) -
+                                    _outputs.begin();
 
-        if(_print_map) {
-            for(const auto &input : inputs)
-                std::cout << input << " ";
-            std::cout << std::endl;
-        }
+            //Receive reward from the square the agent is on
+            const int reward = _rewards[_agent];
+            total_reward += reward;
+            prev_reward = reward;
 
-        outputs = org.get_phenotype().activate(inputs);
+            //Move reward
+            if(_switch_square.has_value() && !switched &&
+               total_reward > _switch_total_reward)
+            {
+                std::copy(_switch_rewards.begin(), _switch_rewards.end(), _rewards.begin());
+                distances = &_switch_distances;
+                switched = true;
+            }
 
-        if(_print_map) {
-            for(const auto &output : outputs)
-                std::cout << output << " ";
-            std::cout << std::endl;
-        }
+            //The agent starts again once it has found the reward
+            if(reward > 0)
+            {
+                _agent = _agent_start;
+                prev_action.reset();
+            } else
+            {
+                const unsigned next = _grid->get_move(_agent, action);
+
+                if(_shaping != 0. && (*distances)[_agent] != Grid::UNREACHABLE &&
+                   (*distances)[next] != Grid::UNREACHABLE)
+                    shaped_reward += _shaping * ((double)(*distances)[_agent] -
+                                                 (double)(*distances)[next]);
+
+                _agent = next;
+                prev_action = action;
+            }
 
-        auto max_element_index = std::max_element(outputs.begin(), 
-                                                  outputs.end()) - outputs.begin();
-
-        //Receive reward from new state
-        int reward = _grid.get_reward(_grid.get_agent_x(), _grid.get_agent_y());
-        _total_reward += reward;
-        _prev_reward = reward;
-
-        std::vector<bool> action_bools(4, false);
-
-        //Move reward
-        if(_total_reward > 20)
-            _grid.move_reward(9, 6);
-            //_grid.move_reward(7, 1);
-
-        //Move agent
-        if(reward > 0)
-            _grid.move_agent(_agent_init_x, _agent_init_y);
-        else {
-
-            //Apply action
-            apply_action(max_element_index);
-
-            switch(max_element_index) {
-                case 0:
-                    action_bools.at(0) = true;
-                    break;
-                case 1:
-                    action_bools.at(1) = true;
-                    break;
-                case 2:
-                    action_bools.at(2) = true;
-                    break;
-                case 3:
-                    action_bools.at(3) = true;
-                    break;
+            if(this->_domain_trace)
+            {
+                std::cout << "Steps: " << step << std::endl;
+                std::cout << "Inputs: ";
+                for(const auto& input : _inputs)
+                    std::cout << input << " ";
+                std::cout << std::endl << "Outputs: ";
+                for(const auto& output : _outputs)
+                    std::cout << output << " ";
+                std::cout << std::endl;
+                std::cout << "State reward: " << reward << std::endl;
+                std::cout << "Total reward: " << total_reward << std::endl << std::endl;
             }
 
         }
 
-        //Assign previous action
-        _prev_action.assign(action_bools.begin(), action_bools.end());
-
-        if(_print_map) {
-            std::cout << "State reward: " << reward << std::endl;
-            std::cout << "Total reward: " << _total_reward << std::endl << std::endl;
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        }
+        return total_reward + shaped_reward;
 
     }
 
-    std::vector<std::vector<bool> > sense_environment() {
-
-        //3x3 binary vector centered on the neighbourhood of the agent
-        //Hard coded numbers for now but can make this generic in the future
-        std::vector<std::vector<bool> > inputs(3, std::vector<bool>(3));
-
-        const unsigned agent_x = _grid.get_agent_x();
-        const unsigned agent_y = _grid.get_agent_y();
-
-        for(unsigned i = agent_y-1; i <= agent_y+1; i++)
-            for(unsigned j = agent_x-1; j <= agent_x+1; j++)
-                inputs.at(i - agent_y+1).at(j - agent_x+1) = (bool)_grid.get_square_type(j, i);
-
-        return inputs;
-
+    void render() override
+    {
+        _grid->print(std::cout, _agent, _rewards);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
 
-    void apply_action(const unsigned action) {
-
-        const unsigned agent_x = _grid.get_agent_x();
-        const unsigned agent_y = _grid.get_agent_y();
-
-        switch(action) {
-
-            //Up
-            case 0:
-                if(_grid.get_square_type(agent_x, agent_y-1) == 0)
-                    _grid.move_agent(agent_x, agent_y-1);
-                break;
-
-            //Down
-            case 1:
-                if(_grid.get_square_type(agent_x, agent_y+1) == 0)
-                    _grid.move_agent(agent_x, agent_y+1);
-                break;
-
-            //Left
-            case 2:
-                if(_grid.get_square_type(agent_x-1, agent_y) == 0)
-                    _grid.move_agent(agent_x-1, agent_y);
-                break;
-
-            //Right
-            case 3:
-                if(_grid.get_square_type(agent_x+1, agent_y) == 0)
-                    _grid.move_agent(agent_x+1, agent_y);
-                break;
-
+    void exp_run_reset_impl(const unsigned, const std::optional<unsigned>&) override {}
+
+    void trial_reset(const unsigned) override {}
+
+    JSON to_json_impl() const override
+    {
+        JSON json;
+        json.emplace("name", "Maze");
+        json.emplace("grid_file", _grid->get_file_name());
+        json.emplace("reward_input", _reward_input);
+        json.emplace("action_input", _action_input);
+        json.emplace("max_steps", _max_steps);
+        json.emplace("shaping", _shaping);
+        json.emplace("agent_start_x", _agent_start_x);
+        json.emplace("agent_start_y", _agent_start_y);
+        json.emplace("switch", _switch_square.has_value());
+        if(_switch_square.has_value())
+        {
+            json.emplace("switch_x", _switch_square->first);
+            json.emplace("switch_y", _switch_square->second);
         }
-
+        json.emplace("switch_total_reward", _switch_total_reward);
+        json.emplace("completion_fitness", this->_completion_fitness);
+        json.emplace("render", this->_render);
+        return json;
     }
 
-    void rand_agent_teleport() {
-
-        //Generate numbers until an empty square is landed
-        int x;
-        int y;
-
-        do {
-
-            x = _uni_dist(_rng);
-            y = _uni_dist(_rng);
-
-        } while(_grid.get_square_type(x, y) != 0 || _grid.get_reward(x, y) != 0);
-
-        _grid.move_agent(x, y);
-
+    //The switch square defaults to (9, 6), as in the constructor, and "switch"
+    //set to false turns switching off
+    static std::optional<std::pair<unsigned, unsigned>> switch_square_from_json(
+        const JSON& json)
+    {
+        if(!json.value({"switch"}, true))
+            return std::nullopt;
+        return std::make_pair(json.value({"switch_x"}, 9u),
+                              json.value({"switch_y"}, 6u));
     }
 
-    void rand_move_reward() {
-
-        //Generate numbers until an empty square is landed
-        int x;
-        int y;
-
-        do {
-
-            x = _uni_dist(_rng);
-            y = _uni_dist(_rng);
+    Maze<G>* clone_impl() const override
+    {
+        return new Maze<G>(*this);
+    }
 
-        } while(_grid.get_square_type(x, y) != 0);
+    unsigned num_inputs() const
+    {
+        return Grid::OBSERVATION_SIZE + (_reward_input ? 1 : 0) +
+               (_action_input ? Grid::NUM_ACTIONS : 0);
+    }
 
-        _grid.move_reward(x, y);
+    unsigned square_in_grid(const unsigned x, const unsigned y) const
+    {
+        if(x >= _grid->get_width() || y >= _grid->get_height() ||
+           _grid->is_wall(_grid->square(x, y)))
+            throw std::invalid_argument("(" + std::to_string(x) + ", " +
+                                        std::to_string(y) + ") is not an empty square of " +
+                                        _grid->get_file_name());
+        return _grid->square(x, y);
+    }
 
+    //The rewards once they have been switched, where every reward is moved to
+    //the switch square
+    std::vector<int> switched_rewards() const
+    {
+        if(!_switch_square.has_value())
+            return _start_rewards;
+
+        std::vector<int> rewards(_start_rewards.size(), 0);
+        rewards[square_in_grid(_switch_square->first, _switch_square->second)] =
+            *std::max_element(_start_rewards.begin(), _start_rewards.end());
+        return rewards;
     }
 
-    const unsigned _agent_init_x;
-    const unsigned _agent_init_y;
+    //Shared by copies of the domain
+    const std::shared_ptr<const Grid> _grid;
 
-    const std::string _grid_file_name;
-    Grid _grid;
+    const bool _reward_input;
+    const bool _action_input;
 
     const unsigned _max_steps;
+    const double _shaping;
 
-    const bool _print_map;
+    const unsigned _agent_start_x;
+    const unsigned _agent_start_y;
+    const unsigned _agent_start;
 
-    const bool _reward_input;
-    const bool _action_input;
-    int _prev_reward;
-    std::vector<bool> _prev_action;
+    const std::optional<std::pair<unsigned, unsigned>> _switch_square;
+    const int _switch_total_reward;
 
-    int _total_reward;
+    const std::vector<int> _start_rewards;
+    const std::vector<int> _switch_rewards;
+    const std::vector<unsigned> _start_distances;
+    const std::vector<unsigned> _switch_distances;
 
-    //Random uniform distribution for generating coordinates in grid
-    std::mt19937 _rng;
-    std::uniform_int_distribution<int> _uni_dist;
+    //State of the current trial, reused between trials
+    std::vector<int> _rewards;
+    unsigned _agent;
+    std::vector<double> _inputs;
+    std::vector<double> _outputs;
 
 };
 
+static Factory<Domain<double, double>>::Registrar maze_registrar("Maze",
+    [](const JSON& json) {return std::make_shared<Maze<double>>(json);});
+
 } // namespace NeuroEvo
 
 #endif
@@ -13,6 +13,9 @@
 */
 
 #include <domains/domain.h>
+#include <domains/control_domains/cart_pole_batch.h>
+#include <phenotype/phenotype_specs/network_builder.h>
+#include <array>
 #include <thread>
 
 namespace NeuroEvo {
@@ -93,7 +96,10 @@ public:
         _starting_theta(starting_theta),
         _starting_theta_dot(starting_theta_dot),
         _print_state_to_file(print_state),
-        _state_file_name(std::string(DATA_PATH) + "/single_cp_state") {}
+        _state_file_name(std::string(DATA_PATH) + "/single_cp_state"),
+        _batch(_cart_pole.specs.gravity, _cart_pole.specs.cart_mass,
+               _cart_pole.specs.pole_mass, _cart_pole.specs.pole_half_length,
+               _cart_pole.specs.tau, _boundary, _cart_pole.fortyfive_degrees) {}
 
     SingleCartPole(const JSON& json) :
         Domain<G, double>(json, json.value({"max_steps"}, 1e5)),
@@ -112,80 +118,98 @@ public:
         _starting_theta(json.value({"starting_theta"}, 0.0)),
         _starting_theta_dot(json.value({"starting_theta_dot"}, 0.0)),
         _print_state_to_file(false),
-        _state_file_name(std::string(DATA_PATH) + "/single_cp_state") {}
-
+        _state_file_name(std::string(DATA_PATH) + "/single_cp_state"),
+        _batch(_cart_pole.specs.gravity, _cart_pole.specs.cart_mass,
+               _cart_pole.specs.pole_mass, _cart_pole.specs.pole_half_length,
+               _cart_pole.specs.tau, _boundary, _cart_pole.fortyfive_degrees) {}
+
+    //Runs one cart for every organism and trial and steps all of the carts
+    //together. Each cart is controlled by its own copy of the organism's
+    //phenotype, so a network with state starts every trial afresh, as it does
+    //when the trials are run one at a time.
+    using Domain<G, double>::evaluate_trials;
+
+    std::vector<double> evaluate_trials(Population<G, double>& pop,
+                                        const std::vector<unsigned>& trial_seeds,
+                                        const std::size_t first_org,
+                                        const std::size_t last_org,
+                                        const std::size_t first_trial,
+                                        const std::size_t last_trial) override
+    {
+        //Rendering, tracing, printing the state and recording trajectories
+        //follow one cart at a time
+        if(this->_render || this->_domain_trace || _print_state_to_file ||
+           this->recording_trajectories())
+            return Domain<G, double>::evaluate_trials(pop, trial_seeds, first_org,
+                                                      last_org, first_trial,
+                                                      last_trial);
+
+        const std::size_t num_trials = last_trial - first_trial;
+        const std::size_t num_carts = (last_org - first_org) * num_trials;
+
+        std::vector<std::unique_ptr<Phenotype<double>>> phenotypes;
+        phenotypes.reserve(num_carts);
+        for(std::size_t i = first_org; i < last_org; i++)
+        {
+            Organism<G, double>& org = pop.get_mutable_organism(i);
+            org.genesis();
+            for(std::size_t j = 0; j < num_trials; j++)
+                phenotypes.push_back(org.get_phenotype().clone_phenotype());
+        }
 
-private:
+        _batch.reset(num_carts);
+        for(std::size_t i = 0; i < num_carts; i++)
+        {
+            const std::array<double, 4> start = start_state(
+                trial_seeds[first_trial + i % num_trials]);
+            _batch.set_state(i, start[0], start[1], start[2], start[3]);
+        }
 
-    double single_run(Organism<G, double>& org, unsigned rand_seed) override
-    {
-        //Seed random number generator with same seed as other members of the population
-        srand48(rand_seed);
+        std::vector<double> inputs(_markovian ? 4 : 2);
+        Eigen::ArrayXd forces;
 
-        if(_random_start) {
+        for(unsigned step = 0; step < _max_steps && !_batch.all_failed(); step++)
+        {
+            forces.setZero(_batch.get_num_slots());
 
-            double x_lb, x_ub, x_dot_lb, x_dot_ub,
-                   theta_lb, theta_ub, theta_dot_lb, theta_dot_ub;
-            if(_markovian)
+            for(std::size_t i = 0; i < _batch.get_num_slots(); i++)
             {
-               x_lb = -2.;
-               x_ub = 2.;
-               x_dot_lb = -1.;
-               x_dot_ub = 1.;
-               theta_lb = -0.16;
-               theta_ub = 0.16;
-               theta_dot_lb = -1.;
-               theta_dot_ub = 1.;
-            } else
-            {
-               x_lb = -1.;
-               x_ub = 1.;
-               x_dot_lb = -1.;
-               x_dot_ub = 1.;
-               theta_lb = -0.2;
-               theta_ub = 0.2;
-               theta_dot_lb = -1.;
-               theta_dot_ub = 1.;
-            }
+                if(!_batch.running(i))
+                    continue;
 
-            //[-2.4, 2.4]
-            //const double x_rand = (lrand48()%4800)/1000.0 - 2.4;
-            const double x_rand = UniformRealDistribution::get(x_lb, x_ub, rand_seed);
-            //[-1., 1.]
-            //const double x_dot_rand = (lrand48()%2000)/1000.0 - 1.0;
-            const double x_dot_rand = UniformRealDistribution::get(x_dot_lb, x_dot_ub,
-                                                                   rand_seed);
-            //[-0.2, 0.2]
-            //const double theta_rand = (lrand48()%400)/1000.0 - 0.2
-            const double theta_rand = UniformRealDistribution::get(theta_lb, theta_ub,
-                                                                   rand_seed);
-            //[-1.5, 1.5]
-            //const double theta_dot_rand = (lrand48()%3000)/1000.0 - 1.5;
-            const double theta_dot_rand = UniformRealDistribution::get(theta_dot_lb,
-                                                                       theta_dot_ub,
-                                                                       rand_seed);
-
-            /*
-            std::cout << "x rand: " << x_rand << std::endl;
-            std::cout << "x_dot rand: " << x_dot_rand << std::endl;
-            std::cout << "theta rand: " << theta_rand << std::endl;
-            std::cout << "theta_dot rand: " << theta_dot_rand << std::endl;
-            */
-
-            _cart_pole.x = x_rand;
-            _cart_pole.x_dot = x_dot_rand;
-            _cart_pole.theta = theta_rand;
-            _cart_pole.theta_dot = theta_dot_rand;
-
-        } else {
-
-            _cart_pole.x = _starting_x;
-            _cart_pole.x_dot = _starting_x_dot;
-            _cart_pole.theta = _starting_theta;
-            _cart_pole.theta_dot = _starting_theta_dot;
+                set_inputs(inputs, _batch.get_x()(i), _batch.get_x_dot()(i),
+                           _batch.get_theta()(i), _batch.get_theta_dot()(i));
 
+                const std::vector<double> outputs =
+                    phenotypes[_batch.get_cart(i)]->activate(inputs);
+
+                if(_continuous_actuator)
+                    forces(i) = calculate_continuous_force(outputs);
+                else
+                    forces(i) = calculate_discrete_force(outputs);
+            }
+
+            _batch.step(forces);
         }
 
+        //single_run counts one step past max_steps for a cart that never fails
+        std::vector<double> fitnesses(num_carts);
+        for(std::size_t i = 0; i < num_carts; i++)
+            fitnesses[i] = _batch.failed(i) ? _batch.get_steps(i) : _max_steps + 1;
+
+        return fitnesses;
+    }
+
+private:
+
+    double single_run(Organism<G, double>& org, unsigned rand_seed) override
+    {
+        const std::array<double, 4> start = start_state(rand_seed);
+        _cart_pole.x = start[0];
+        _cart_pole.x_dot = start[1];
+        _cart_pole.theta = start[2];
+        _cart_pole.theta_dot = start[3];
+
         unsigned steps = 0;
 
         //Number of inputs for the markovian version is 4
@@ -197,11 +221,16 @@ private:
 
         std::vector<double> outputs(2);
 
+        //Opened once for the whole episode
+        std::ofstream state_file;
+        if(_print_state_to_file)
+            state_file.open(_state_file_name, std::fstream::app);
+
         //Start interaction loop
         while(steps++ < _max_steps)
         {
 
-            if(_print_state_to_file) print_state_to_file(_cart_pole);
+            if(_print_state_to_file) print_state_to_file(state_file, _cart_pole);
 
             if(this->_domain_trace)
             {
@@ -211,22 +240,8 @@ private:
                 std::cout << "theta_dot: " << _cart_pole.theta_dot << std::endl;
             }
 
-            //Not sure what these random constants are
-            if(_markovian)
-            {
-
-                inputs.at(0) = (_cart_pole.x + 2.4) / 4.8;
-                inputs.at(1) = (_cart_pole.x_dot + 0.75) / 1.5;
-                inputs.at(2) = (_cart_pole.theta + _cart_pole.twelve_degrees) / 0.41;
-                inputs.at(3) = (_cart_pole.theta_dot + 1.0) / 2.0;
-
-            } else
-            {
-
-                inputs.at(0) = (_cart_pole.x + 2.4) / 4.8;
-                inputs.at(1) = (_cart_pole.theta + _cart_pole.twelve_degrees) / 0.41;
-
-            }
+            set_inputs(inputs, _cart_pole.x, _cart_pole.x_dot, _cart_pole.theta,
+                       _cart_pole.theta_dot);
 
             outputs = org.get_phenotype().activate(inputs);
 
@@ -236,6 +251,13 @@ private:
             else
                 force = calculate_discrete_force(outputs);
 
+            //A reward of one for every step the pole stays up
+            if(this->recording_trajectories())
+            {
+                this->record_step(inputs, {force});
+                this->record_reward(1.);
+            }
+
             const double cos_theta = cos(_cart_pole.theta);
             const double sin_theta = sin(_cart_pole.theta);
 
@@ -278,6 +300,82 @@ private:
 
     }
 
+    //The start state is drawn from the seed shared by all members of the
+    //population, with one counter per state variable so the variables are
+    //independent of one another
+    std::array<double, 4> start_state(const unsigned rand_seed) const
+    {
+
+        if(!_random_start)
+            return {_starting_x, _starting_x_dot, _starting_theta, _starting_theta_dot};
+
+        double x_lb, x_ub, x_dot_lb, x_dot_ub,
+               theta_lb, theta_ub, theta_dot_lb, theta_dot_ub;
+        if(_markovian)
+        {
+           x_lb = -2.;
+           x_ub = 2.;
+           x_dot_lb = -1.;
+           x_dot_ub = 1.;
+           theta_lb = -0.16;
+           theta_ub = 0.16;
+           theta_dot_lb = -1.;
+           theta_dot_ub = 1.;
+        } else
+        {
+           x_lb = -1.;
+           x_ub = 1.;
+           x_dot_lb = -1.;
+           x_dot_ub = 1.;
+           theta_lb = -0.2;
+           theta_ub = 0.2;
+           theta_dot_lb = -1.;
+           theta_dot_ub = 1.;
+        }
+
+        //[-2.4, 2.4]
+        //const double x_rand = (lrand48()%4800)/1000.0 - 2.4;
+        const double x_rand = UniformRealDistribution::get(x_lb, x_ub, rand_seed, 0);
+        //[-1., 1.]
+        //const double x_dot_rand = (lrand48()%2000)/1000.0 - 1.0;
+        const double x_dot_rand = UniformRealDistribution::get(x_dot_lb, x_dot_ub,
+                                                               rand_seed, 1);
+        //[-0.2, 0.2]
+        //const double theta_rand = (lrand48()%400)/1000.0 - 0.2
+        const double theta_rand = UniformRealDistribution::get(theta_lb, theta_ub,
+                                                               rand_seed, 2);
+        //[-1.5, 1.5]
+        //const double theta_dot_rand = (lrand48()%3000)/1000.0 - 1.5;
+        const double theta_dot_rand = UniformRealDistribution::get(theta_dot_lb,
+                                                                   theta_dot_ub,
+                                                                   rand_seed, 3);
+
+        return {x_rand, x_dot_rand, theta_rand, theta_dot_rand};
+
+    }
+
+    //Network inputs for a cart pole state
+    void set_inputs(std::vector<double>& inputs, const double x, const double x_dot,
+                    const double theta, const double theta_dot) const
+    {
+        //Not sure what these random constants are
+        if(_markovian)
+        {
+
+            inputs[0] = (x + 2.4) / 4.8;
+            inputs[1] = (x_dot + 0.75) / 1.5;
+            inputs[2] = (theta + _cart_pole.twelve_degrees) / 0.41;
+            inputs[3] = (theta_dot + 1.0) / 2.0;
+
+        } else
+        {
+
+            inputs[0] = (x + 2.4) / 4.8;
+            inputs[1] = (theta + _cart_pole.twelve_degrees) / 0.41;
+
+        }
+    }
+
     double calculate_discrete_force(const std::vector<double>& net_outputs) const
     {
         //Decide which way to push based on which output unit it greater
@@ -399,20 +497,15 @@ private:
 
     };
 
-    void print_state_to_file(CartPole& cart_pole)
+    void print_state_to_file(std::ofstream& state_file, const CartPole& cart_pole)
     {
 
-        std::ofstream state_file;
-        state_file.open(_state_file_name, std::fstream::app);
-
         state_file << cart_pole.x << ",";
         state_file << cart_pole.x_dot << ",";
         state_file << cart_pole.theta << ",";
         state_file << cart_pole.theta_dot << ",";
 
-        state_file << std::endl;
-
-        state_file.close();
+        state_file << '\n';
 
     }
 
@@ -566,6 +659,8 @@ private:
     const bool _print_state_to_file;
     const std::string _state_file_name;
 
+    CartPoleBatch _batch;
+
 };
 
 static Factory<Domain<double, double>>::Registrar scp_registrar("SingleCartPole",
@@ -0,0 +1,77 @@
+#ifndef _DATASET_H_
+#define _DATASET_H_
+
+/*
+ * A table of rows of inputs and targets, either mapped straight from a binary
+ * file or copied in from JSON or vectors. The rows are viewed as the columns
+ * of Eigen matrices, one of inputs and one of targets, without copying them.
+ *
+ * The file starts with the bytes NEDS and a u32 version, followed by
+ *     u32 number of inputs, u32 number of targets, u64 number of rows
+ * and then every row, its inputs followed by its targets as f64 values, in
+ * native byte order. scripts/dataset.py writes these files.
+ */
+
+#include <Eigen/Dense>
+#include <data/json.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace NeuroEvo {
+
+class Dataset
+{
+
+public:
+
+    //Each column is one row of the dataset
+    typedef Eigen::Map<const Eigen::MatrixXd, 0, Eigen::OuterStride<>> Columns;
+
+    //Maps a dataset file
+    Dataset(const std::string& file_name);
+
+    Dataset(const std::vector<std::vector<double>>& inputs,
+            const std::vector<std::vector<double>>& targets);
+
+    //Either a file, or the inputs and targets of every row
+    Dataset(const JSON& json);
+
+    Dataset(const Dataset&) = delete;
+    Dataset& operator=(const Dataset&) = delete;
+
+    ~Dataset();
+
+    uint32_t get_num_inputs() const;
+    uint32_t get_num_targets() const;
+    uint64_t get_num_rows() const;
+
+    Columns get_inputs() const;
+    Columns get_targets() const;
+
+    JSON to_json() const;
+
+private:
+
+    void map_file(const std::string& file_name);
+    void copy_rows(const std::vector<std::vector<double>>& inputs,
+                   const std::vector<std::vector<double>>& targets);
+
+    std::string _file_name;
+
+    uint32_t _num_inputs;
+    uint32_t _num_targets;
+    uint64_t _num_rows;
+
+    //Every row one after the other, in the mapped file or in _rows
+    const double* _data;
+
+    void* _mapping;
+    std::size_t _mapping_size;
+    std::vector<double> _rows;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
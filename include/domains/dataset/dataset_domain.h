@@ -0,0 +1,168 @@
+#ifndef _DATASET_DOMAIN_H_
+#define _DATASET_DOMAIN_H_
+
+/*
+ * Scores a network on every row of a dataset with a loss, so supervised tasks
+ * can be evolved on tables of inputs and targets.
+ * Networks without state are activated on many rows at once, with a matrix
+ * product per layer, instead of once for every row.
+ */
+
+#include <domains/domain.h>
+#include <domains/dataset/dataset.h>
+#include <domains/dataset/dataset_loss.h>
+#include <phenotype/phenotype_specs/network_builder.h>
+#include <phenotype/neural_network/network.h>
+
+namespace NeuroEvo {
+
+template <typename G>
+class DatasetDomain : public Domain<G, double>
+{
+
+public:
+
+    DatasetDomain(const std::shared_ptr<const Dataset>& dataset,
+                  const std::shared_ptr<const DatasetLoss>& loss,
+                  const double completion_fitness = 0.,
+                  const bool domain_trace = false,
+                  const unsigned batch_rows = 4096) :
+        Domain<G, double>(domain_trace, completion_fitness),
+        _dataset(dataset),
+        _loss(loss),
+        _batch_rows(batch_rows) {}
+
+    DatasetDomain(const JSON& json) :
+        Domain<G, double>(json, json.value({"completion_fitness"}, 0.)),
+        _dataset(std::make_shared<const Dataset>(JSON(json.at({"Dataset"})))),
+        _loss(Factory<DatasetLoss>::create(json.at({"Loss"}))),
+        _batch_rows(json.value({"batch_rows"}, 4096u)) {}
+
+    bool check_phenotype_spec(const PhenotypeSpec& pheno_spec) const override
+    {
+        const NetworkBuilder* network_builder =
+            dynamic_cast<const NetworkBuilder*>(&pheno_spec);
+
+        //If it is not a network
+        if(network_builder == nullptr)
+        {
+            std::cout << "Only network specifications are allowed with" <<
+                        " the dataset domain!" << std::endl;
+            return false;
+        }
+
+        if(network_builder->get_num_inputs() != _dataset->get_num_inputs())
+        {
+            std::cerr << "Number of inputs must be " << _dataset->get_num_inputs() <<
+                " for this dataset!" << std::endl;
+            return false;
+        }
+
+        if(network_builder->get_num_outputs() != _dataset->get_num_targets())
+        {
+            std::cerr << "Number of outputs must be " << _dataset->get_num_targets() <<
+                " for this dataset!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+
+    //Average score of the rows
+    double single_run(Organism<G, double>& org, unsigned) override
+    {
+        Phenotype<double>& phenotype = org.get_phenotype();
+        Network* network = dynamic_cast<Network*>(&phenotype);
+
+        const Dataset::Columns inputs = _dataset->get_inputs();
+        const Dataset::Columns targets = _dataset->get_targets();
+        const Eigen::Index num_rows = inputs.cols();
+
+        double score = 0.;
+
+        //The rows are activated _batch_rows at a time to bound the memory of
+        //the layer outputs
+        if(network && network->batchable() && !this->_domain_trace)
+        {
+            for(Eigen::Index first = 0; first < num_rows; first += _batch_rows)
+            {
+                const Eigen::Index batch_size =
+                    std::min<Eigen::Index>(_batch_rows, num_rows - first);
+                network->activate_batch(inputs.middleCols(first, batch_size), _outputs);
+                score += _loss->score(_outputs, targets.middleCols(first, batch_size));
+            }
+
+            return score / num_rows;
+        }
+
+        _row_inputs.resize(inputs.rows());
+
+        for(Eigen::Index i = 0; i < num_rows; i++)
+        {
+            Eigen::VectorXd::Map(_row_inputs.data(), _row_inputs.size()) = inputs.col(i);
+            phenotype.activate_into(_row_inputs, _row_outputs);
+
+            const Eigen::Map<const Eigen::MatrixXd> row_outputs(_row_outputs.data(),
+                                                                _row_outputs.size(), 1);
+            score += _loss->score(row_outputs, targets.col(i));
+
+            if(this->_domain_trace)
+            {
+                std::cout << "Inputs: ";
+                for(const auto& input : _row_inputs)
+                    std::cout << input << " ";
+                std::cout << "| Target: " << targets.col(i).transpose() <<
+                    " | Network output: ";
+                for(const auto& output : _row_outputs)
+                    std::cout << output << " ";
+                std::cout << std::endl;
+            }
+        }
+
+        return score / num_rows;
+    }
+
+    void render() override {}
+
+    void exp_run_reset_impl(const unsigned, const std::optional<unsigned>&) override {}
+
+    void trial_reset(const unsigned) override {}
+
+    JSON to_json_impl() const override
+    {
+        JSON json;
+        json.emplace("name", "DatasetDomain");
+        json.emplace("Dataset", _dataset->to_json());
+        json.emplace("Loss", _loss->to_json());
+        json.emplace("batch_rows", _batch_rows);
+        return json;
+    }
+
+    DatasetDomain<G>* clone_impl() const override
+    {
+        return new DatasetDomain<G>(*this);
+    }
+
+    //Shared by copies of the domain
+    const std::shared_ptr<const Dataset> _dataset;
+    const std::shared_ptr<const DatasetLoss> _loss;
+
+    const unsigned _batch_rows;
+
+    //Reused between evaluations
+    Eigen::MatrixXd _outputs;
+    std::vector<double> _row_inputs;
+    std::vector<double> _row_outputs;
+
+};
+
+static Factory<Domain<double, double>>::Registrar dataset_domain_registrar(
+    "DatasetDomain",
+    [](const JSON& json)
+    {return std::make_shared<DatasetDomain<double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef _DATASET_LOSS_H_
+#define _DATASET_LOSS_H_
+
+/*
+ * Scores the outputs of a network against the targets of a dataset, where each
+ * column holds the outputs or targets of one row. Scores are summed over the
+ * rows and higher is better, so errors are negated.
+ */
+
+#include <Eigen/Dense>
+#include <util/factory.h>
+
+namespace NeuroEvo {
+
+class DatasetLoss
+{
+
+public:
+
+    virtual ~DatasetLoss() = default;
+
+    virtual double score(const Eigen::Ref<const Eigen::MatrixXd>& outputs,
+                         const Eigen::Ref<const Eigen::MatrixXd>& targets) const = 0;
+
+    virtual JSON to_json() const = 0;
+
+};
+
+//Negative absolute error, averaged over the targets of a row
+class AbsErrorLoss : public DatasetLoss
+{
+
+public:
+
+    double score(const Eigen::Ref<const Eigen::MatrixXd>& outputs,
+                 const Eigen::Ref<const Eigen::MatrixXd>& targets) const override;
+
+    JSON to_json() const override;
+
+};
+
+//Negative squared error, averaged over the targets of a row
+class MSELoss : public DatasetLoss
+{
+
+public:
+
+    double score(const Eigen::Ref<const Eigen::MatrixXd>& outputs,
+                 const Eigen::Ref<const Eigen::MatrixXd>& targets) const override;
+
+    JSON to_json() const override;
+
+};
+
+//1 for every row classified correctly. A single output is a binary class,
+//on either side of threshold, and several outputs are one class each, the
+//largest being the class chosen.
+class AccuracyLoss : public DatasetLoss
+{
+
+public:
+
+    AccuracyLoss(const double threshold = 0.5);
+    AccuracyLoss(const JSON& json);
+
+    double score(const Eigen::Ref<const Eigen::MatrixXd>& outputs,
+                 const Eigen::Ref<const Eigen::MatrixXd>& targets) const override;
+
+    JSON to_json() const override;
+
+private:
+
+    const double _threshold;
+
+};
+
+static Factory<DatasetLoss>::Registrar abs_error_loss_registrar("AbsErrorLoss",
+    [](const JSON&) {return std::make_shared<AbsErrorLoss>();});
+
+static Factory<DatasetLoss>::Registrar mse_loss_registrar("MSELoss",
+    [](const JSON&) {return std::make_shared<MSELoss>();});
+
+static Factory<DatasetLoss>::Registrar accuracy_loss_registrar("AccuracyLoss",
+    [](const JSON& json) {return std::make_shared<AccuracyLoss>(json);});
+
+} // namespace NeuroEvo
+
+#endif
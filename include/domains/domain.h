@@ -18,6 +18,10 @@
 #include <SFML/Graphics.hpp>
 #endif
 
+#if RECORD_TRAJECTORIES
+#include <util/recording/trajectory_recorder.h>
+#endif
+
 namespace NeuroEvo {
 
 inline std::mutex mtx;
@@ -40,7 +44,7 @@ public:
         _screen_width(screen_width),
         _screen_height(screen_height)
     {
-        if(_seed.has_value())
+        if(seed.has_value())
             set_seed(seed);
 
 #if SFML_FOUND
@@ -58,6 +62,9 @@ public:
         _screen_width(domain._screen_width),
         _screen_height(domain._screen_height),
         _domain_hyperparams(domain._domain_hyperparams)
+#if RECORD_TRAJECTORIES
+        , _trajectory_recorder(domain._trajectory_recorder)
+#endif
     {
         if(domain._seed.has_value())
             set_seed(domain._seed);
@@ -79,18 +86,79 @@ public:
     {
         if(json.has_value({"seed"}))
             set_seed(json.at({"seed"}));
+
+#if RECORD_TRAJECTORIES
+        if(json.has_value({"trajectory_file"}))
+            _trajectory_recorder = std::make_shared<TrajectoryRecorder>(
+                json.get<std::string>({"trajectory_file"})
+            );
+#endif
     }
 
     virtual ~Domain() = default;
 
-    // Evaluate single organism and return fitness
-    double evaluate(Organism<G, T>& org)
+    //Draws the seeds of the next set of trials. The same seeds should be used
+    //for every organism in a generation so they are all run on the same trials.
+    std::vector<unsigned> next_trial_seeds(const unsigned num_trials)
+    {
+        std::vector<unsigned> trial_seeds(num_trials);
+        for(auto& trial_seed : trial_seeds)
+            trial_seed = _trial_seed_sequence.next();
+        return trial_seeds;
+    }
+
+    //Evaluate single organism on one trial and return fitness
+    //Trials only depend on the trial number and seed so they can be run in any
+    //order, or in parallel on copies of the domain
+    double evaluate_trial(Organism<G, T>& org, const unsigned trial_num,
+                          const unsigned trial_seed)
     {
         //Need to reset the network
         org.genesis();
-        // Trial seed set to 108 right now, change if one wants seed to change 
-        // for each trial
-        return single_run(org, 108);
+        trial_reset(trial_num);
+        org_reset();
+        return recorded_single_run(org, trial_seed);
+    }
+
+    //Evaluate single organism on every trial and return the average fitness
+    double evaluate(Organism<G, T>& org, const std::vector<unsigned>& trial_seeds)
+    {
+        double total_fitness = 0.0;
+        for(std::size_t i = 0; i < trial_seeds.size(); i++)
+            total_fitness += evaluate_trial(org, i, trial_seeds[i]);
+        return total_fitness / trial_seeds.size();
+    }
+
+    //Evaluate every organism of the population on every trial and return the
+    //fitnesses indexed by org * num_trials + trial
+    std::vector<double> evaluate_trials(Population<G, T>& pop,
+                                        const std::vector<unsigned>& trial_seeds)
+    {
+        return evaluate_trials(pop, trial_seeds, 0, pop.get_size(), 0,
+                               trial_seeds.size());
+    }
+
+    //Evaluate the organisms from first_org up to last_org on the trials from
+    //first_trial up to last_trial and return the fitnesses indexed by
+    //(org - first_org) * (last_trial - first_trial) + trial - first_trial
+    //Only those organisms are touched, so disjoint ranges of a population can
+    //be evaluated at the same time on copies of the domain
+    //Domains that can run many organisms in lock step override this, by
+    //default each organism is evaluated on each trial in turn
+    virtual std::vector<double> evaluate_trials(Population<G, T>& pop,
+                                                const std::vector<unsigned>& trial_seeds,
+                                                const std::size_t first_org,
+                                                const std::size_t last_org,
+                                                const std::size_t first_trial,
+                                                const std::size_t last_trial)
+    {
+        std::vector<double> fitnesses;
+        fitnesses.reserve((last_org - first_org) * (last_trial - first_trial));
+        for(std::size_t i = first_org; i < last_org; i++)
+            for(std::size_t j = first_trial; j < last_trial; j++)
+                fitnesses.push_back(evaluate_trial(pop.get_mutable_organism(i), j,
+                                                   trial_seeds[j]));
+        return fitnesses;
     }
 
 
@@ -143,7 +211,7 @@ public:
             const auto trial_seed = _trial_seed_sequence.next();
             trial_reset(i);
 
-            fitnesses.at(i) = single_run(org, trial_seed);
+            fitnesses.at(i) = recorded_single_run(org, trial_seed);
 
             if(verbosity)
                 std::cout << "Run: " << i << " Fitness: " << fitnesses.at(i)
@@ -179,7 +247,7 @@ public:
         if(indv_run)
             exp_run_reset_impl(run_num, std::nullopt);
         else
-            exp_run_reset_impl(run_num, _run_seed_sequence.next());
+            exp_run_reset_impl(run_num, run_seed(run_num));
         mtx.unlock();
     }
 
@@ -207,13 +275,21 @@ public:
         _domain_trace = trace;
     }
 
+#if RECORD_TRAJECTORIES
+    //Records the trajectory of every episode run by this domain and the copies
+    //made of it from now on
+    void set_trajectory_recorder(const std::shared_ptr<TrajectoryRecorder>& recorder)
+    {
+        _trajectory_recorder = recorder;
+    }
+#endif
+
     void set_seed(const std::optional<const unsigned>& seed)
     {
         _seed = seed;
         if(_seed.has_value())
         {
             _trial_seed_sequence.set_seed(_seed.value());
-            _run_seed_sequence.set_seed(_seed.value());
         }
     }
 
@@ -248,11 +324,7 @@ public:
     //Checks domain for completion - can be overriden
     virtual bool check_for_completion(Population<G, T>& population)
     {
-        for(const auto& org : population.get_organisms())
-            if(org.is_domain_winner())
-                return true;
-
-        return false;
+        return population.get_domain_winners().count() > 0;
     }
 
 protected:
@@ -284,6 +356,47 @@ protected:
     //Reset after each organism is evaluated
     virtual void org_reset() {}
 
+    //The seed of each run is derived from the domain seed and the run number
+    //alone so runs can be reset in any order, or in parallel, and still
+    //receive the same seed
+    unsigned run_seed(const unsigned run_num) const
+    {
+        if(_seed.has_value())
+            return static_cast<unsigned>(CounterRNG::derive_seed(_seed.value(),
+                                                                 {run_num}));
+        else
+            return static_cast<unsigned>(CounterRNG::random_seed());
+    }
+
+    //Domains record their trajectories through these, which compile to nothing
+    //unless RECORD_TRAJECTORIES is set. Each step records the observation an
+    //action was chosen from and the action, followed by the reward for it.
+    bool recording_trajectories() const
+    {
+#if RECORD_TRAJECTORIES
+        return _trajectory_recorder != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    void record_step([[maybe_unused]] const std::vector<double>& observation,
+                     [[maybe_unused]] const std::vector<double>& action)
+    {
+#if RECORD_TRAJECTORIES
+        if(_trajectory_recorder)
+            _trajectory.record_step(observation, action);
+#endif
+    }
+
+    void record_reward([[maybe_unused]] const double reward)
+    {
+#if RECORD_TRAJECTORIES
+        if(_trajectory_recorder)
+            _trajectory.record_reward(reward);
+#endif
+    }
+
     //Set domain hyperparameters
     void set_hyperparams(const std::vector<double>& hyperparams)
     {
@@ -305,7 +418,6 @@ protected:
     //We need a sequence of seeds to hand to each single run
     //This sequence of seeds is seeded with _seed... sorry :/
     UniformUnsignedDistribution _trial_seed_sequence;
-    inline static UniformUnsignedDistribution _run_seed_sequence;
 
     //Rendering variables
     bool _render;
@@ -319,6 +431,21 @@ protected:
 
 private:
 
+    //Runs single_run, recording its trajectory if trajectories are recorded
+    double recorded_single_run(Organism<G, T>& org, const unsigned rand_seed)
+    {
+#if RECORD_TRAJECTORIES
+        if(_trajectory_recorder)
+        {
+            _trajectory = _trajectory_recorder->start();
+            const double fitness = single_run(org, rand_seed);
+            _trajectory_recorder->finish(std::move(_trajectory));
+            return fitness;
+        }
+#endif
+        return single_run(org, rand_seed);
+    }
+
     std::vector<std::vector<double>> evaluate_pop_serial(Population<G, T>& pop,
                                                          const unsigned num_trials)
     {
@@ -336,7 +463,8 @@ private:
             for(std::size_t j = 0; j < pop.get_size(); j++)
             {
                 org_reset();
-                const double fitness = single_run(pop.get_mutable_organism(j), seed);
+                const double fitness = recorded_single_run(pop.get_mutable_organism(j),
+                                                           seed);
                 fitnesses[j][i] = fitness;
                 pop.organism_genesis(j);
             }
@@ -463,6 +591,12 @@ private:
     //Domain hyperparameters
     std::optional<std::vector<double>> _domain_hyperparams;
 
+#if RECORD_TRAJECTORIES
+    //Shared by the copies of the domain, each recording its own episodes
+    std::shared_ptr<TrajectoryRecorder> _trajectory_recorder;
+    Trajectory _trajectory;
+#endif
+
 };
 
 } // namespace NeuroEvo
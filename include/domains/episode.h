@@ -0,0 +1,138 @@
+#ifndef _EPISODE_H_
+#define _EPISODE_H_
+
+/*
+ * An episode of a domain written as a coroutine, which co_yields each
+ * observation, is resumed with the outputs of the controller for it and
+ * co_returns its fitness:
+ *
+ *     Episode episode(Organism<G, double>& org, unsigned rand_seed) override
+ *     {
+ *         ...
+ *         const std::vector<double>& outputs = co_yield observation;
+ *         ...
+ *         co_return reward;
+ *     }
+ *
+ * Whoever runs the episode decides how the outputs are worked out, so many
+ * episodes can be suspended at once and have their observations activated
+ * together. The observation and the outputs have to stay alive, and unchanged,
+ * until the episode next suspends.
+ */
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+namespace NeuroEvo {
+
+class Episode
+{
+
+public:
+
+    class promise_type
+    {
+
+    public:
+
+        Episode get_return_object()
+        {
+            return Episode(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        //Nothing runs until the episode is started
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        //Kept around so the fitness can be read once the episode is done
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        //Suspends the episode with its observation and resumes it with the
+        //outputs for the observation
+        auto yield_value(const std::vector<double>& observation) noexcept
+        {
+            _observation = &observation;
+            return OutputsAwaiter{*this};
+        }
+
+        void return_value(const double fitness) noexcept
+        {
+            _fitness = fitness;
+        }
+
+        void unhandled_exception()
+        {
+            _exception = std::current_exception();
+        }
+
+    private:
+
+        friend class Episode;
+
+        struct OutputsAwaiter
+        {
+            promise_type& promise;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<>) const noexcept {}
+
+            const std::vector<double>& await_resume() const noexcept
+            {
+                return *promise._outputs;
+            }
+        };
+
+        const std::vector<double>* _observation = nullptr;
+        const std::vector<double>* _outputs = nullptr;
+        double _fitness = 0.;
+        std::exception_ptr _exception;
+
+    };
+
+    Episode(Episode&& episode) noexcept;
+    Episode& operator=(Episode&& episode) noexcept;
+
+    Episode(const Episode&) = delete;
+    Episode& operator=(const Episode&) = delete;
+
+    ~Episode();
+
+    //Runs the episode up to its first observation
+    void start();
+
+    //Resumes the episode with the outputs for its observation and runs it up to
+    //its next observation
+    void step(const std::vector<double>& outputs);
+
+    bool done() const;
+
+    //The observation the episode is waiting on outputs for
+    const std::vector<double>& get_observation() const;
+
+    //The fitness of an episode that is done
+    double get_fitness() const;
+
+private:
+
+    explicit Episode(const std::coroutine_handle<promise_type> handle);
+
+    //Rethrows anything the episode threw
+    void resume();
+
+    std::coroutine_handle<promise_type> _handle;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
@@ -0,0 +1,284 @@
+#ifndef _EPISODIC_DOMAIN_H_
+#define _EPISODIC_DOMAIN_H_
+
+/*
+ * A domain whose episodes are coroutines (see episode.h) rather than loops
+ * that activate the phenotype themselves.
+ * One episode at a time is run by single_run, which activates the phenotype
+ * on every observation. When max_episodes is over 1, evaluate_trials keeps up
+ * to max_episodes episodes of the population in flight, each in its own copy
+ * of the domain. Every round the waiting observations of every organism whose
+ * network has no state are activated together, in a single call to
+ * Network::activate_batch where each organism's network activates its own
+ * observations, and each episode is resumed. Finished episodes are replaced
+ * by the next episode to run, so episodes of different lengths are batched
+ * without the domain being written for a batch of environments.
+ * Batched activations can differ from activating one observation at a time in
+ * the last bits, as the sums are ordered differently.
+ */
+
+#include <domains/domain.h>
+#include <domains/episode.h>
+#include <phenotype/neural_network/network.h>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <memory>
+
+namespace NeuroEvo {
+
+template <typename G>
+class EpisodicDomain : public Domain<G, double>
+{
+
+public:
+
+    EpisodicDomain(const bool domain_trace = false, const double completion_fitness = 0.0,
+                   const std::optional<unsigned> seed = std::nullopt,
+                   const bool render = false, const unsigned max_episodes = 1) :
+        Domain<G, double>(domain_trace, completion_fitness, seed, render),
+        _max_episodes(max_episodes) {}
+
+    EpisodicDomain(const JSON& json, const double completion_fitness = 0.0) :
+        Domain<G, double>(json, completion_fitness),
+        _max_episodes(json.value({"max_episodes"}, 1u)) {}
+
+    //The episodes in flight belong to the evaluation that started them
+    EpisodicDomain(const EpisodicDomain& domain) :
+        Domain<G, double>(domain),
+        _max_episodes(domain._max_episodes) {}
+
+    void set_max_episodes(const unsigned max_episodes)
+    {
+        _max_episodes = max_episodes;
+    }
+
+    unsigned get_max_episodes() const
+    {
+        return _max_episodes;
+    }
+
+    using Domain<G, double>::evaluate_trials;
+
+    std::vector<double> evaluate_trials(Population<G, double>& pop,
+                                        const std::vector<unsigned>& trial_seeds,
+                                        const std::size_t first_org,
+                                        const std::size_t last_org,
+                                        const std::size_t first_trial,
+                                        const std::size_t last_trial) override
+    {
+        //Tracing, rendering and recording trajectories follow one episode at a
+        //time
+        if(_max_episodes <= 1 || this->_domain_trace || this->_render ||
+           this->recording_trajectories())
+            return Domain<G, double>::evaluate_trials(pop, trial_seeds, first_org,
+                                                      last_org, first_trial,
+                                                      last_trial);
+
+        const std::size_t num_trials = last_trial - first_trial;
+        const std::size_t num_episodes = (last_org - first_org) * num_trials;
+        std::vector<double> fitnesses(num_episodes);
+
+        //Networks without state are shared by every episode of an organism and
+        //any other phenotype is copied for each episode
+        std::vector<Network*> shared_networks(last_org - first_org);
+        for(std::size_t i = first_org; i < last_org; i++)
+        {
+            Organism<G, double>& org = pop.get_mutable_organism(i);
+            org.genesis();
+            Network* network = dynamic_cast<Network*>(&org.get_phenotype());
+            if(network && network->batchable())
+                shared_networks[i - first_org] = network;
+        }
+
+        _slots.resize(std::min<std::size_t>(_max_episodes, num_episodes));
+        std::size_t next_episode = 0;
+
+        //Starts the next episode in slot, skipping over any that finish before
+        //their first observation, and returns whether one was started
+        const auto start_next_episode = [&](Slot& slot)
+        {
+            while(next_episode < num_episodes)
+            {
+                slot.index = next_episode++;
+                const std::size_t org_num = slot.index / num_trials;
+                const std::size_t trial_num = first_trial + slot.index % num_trials;
+                Organism<G, double>& org =
+                    pop.get_mutable_organism(first_org + org_num);
+
+                if(!slot.domain)
+                    slot.domain.reset(static_cast<EpisodicDomain*>(this->clone_impl()));
+                if(!shared_networks[org_num])
+                    slot.phenotype = org.get_phenotype().clone_phenotype();
+
+                slot.domain->trial_reset(trial_num);
+                slot.domain->org_reset();
+                slot.episode.emplace(slot.domain->episode(org, trial_seeds[trial_num]));
+                slot.episode->start();
+
+                if(!slot.episode->done())
+                    return true;
+
+                fitnesses[slot.index] = slot.episode->get_fitness();
+            }
+
+            slot.episode.reset();
+            return false;
+        };
+
+        for(auto& slot : _slots)
+            start_next_episode(slot);
+
+        while(true)
+        {
+            //The episodes waiting on outputs, grouped by organism
+            _waiting.clear();
+            for(std::size_t i = 0; i < _slots.size(); i++)
+                if(_slots[i].episode.has_value())
+                    _waiting.push_back(i);
+
+            if(_waiting.empty())
+                break;
+
+            std::sort(_waiting.begin(), _waiting.end(),
+                      [this](const std::size_t a, const std::size_t b)
+                      {return _slots[a].index < _slots[b].index;});
+
+            //The waiting episodes of shared networks are gathered into one
+            //batch, which is only split where the networks change shape
+            for(const auto i : _waiting)
+            {
+                Slot& slot = _slots[i];
+                Network* network = shared_networks[slot.index / num_trials];
+
+                if(!network)
+                {
+                    slot.phenotype->activate_into(slot.episode->get_observation(),
+                                                  slot.outputs);
+                    continue;
+                }
+
+                if(_batch_networks.empty() || _batch_networks.back() != network)
+                {
+                    if(!_batch_networks.empty() &&
+                       !_batch_networks.front()->same_shape(*network))
+                        activate_batch();
+                    _batch_networks.push_back(network);
+                    _batch_columns.push_back(0);
+                }
+
+                _batch_columns.back()++;
+                _batch_slots.push_back(i);
+            }
+
+            if(!_batch_networks.empty())
+                activate_batch();
+
+            for(const auto i : _waiting)
+            {
+                Slot& slot = _slots[i];
+                slot.episode->step(slot.outputs);
+                if(slot.episode->done())
+                {
+                    fitnesses[slot.index] = slot.episode->get_fitness();
+                    start_next_episode(slot);
+                }
+            }
+        }
+
+        //Copies of the domain are made again by the next evaluation so they
+        //follow any change to the domain in between
+        for(auto& slot : _slots)
+        {
+            slot.domain.reset();
+            slot.phenotype.reset();
+        }
+
+        return fitnesses;
+    }
+
+protected:
+
+    //One episode of org seeded with rand_seed. Anything the episode keeps
+    //between steps lives in the domain or in the coroutine, the outputs are
+    //worked out by whoever runs the episode.
+    virtual Episode episode(Organism<G, double>& org, unsigned rand_seed) = 0;
+
+    unsigned _max_episodes;
+
+private:
+
+    //An episode in flight and the copy of the domain it runs in
+    struct Slot
+    {
+        std::unique_ptr<EpisodicDomain> domain;
+        std::optional<Episode> episode;
+        //(org - first_org) * num_trials + trial - first_trial
+        std::size_t index;
+        //Only for phenotypes that are not shared by the episodes of an organism
+        std::unique_ptr<Phenotype<double>> phenotype;
+        std::vector<double> outputs;
+    };
+
+    double single_run(Organism<G, double>& org, unsigned rand_seed) override
+    {
+        Episode run = episode(org, rand_seed);
+        run.start();
+        while(!run.done())
+        {
+            org.get_phenotype().activate_into(run.get_observation(), _outputs);
+            run.step(_outputs);
+        }
+        return run.get_fitness();
+    }
+
+    //Activates the observations of the slots in _batch_slots as the columns of
+    //one batch, where _batch_networks[i] activates the next _batch_columns[i]
+    //of them, and empties the batch
+    void activate_batch()
+    {
+        const std::size_t batch_size = _batch_slots.size();
+        const std::size_t observation_size =
+            _slots[_batch_slots.front()].episode->get_observation().size();
+
+        if(_batch_observations.rows() != (Eigen::Index)observation_size ||
+           _batch_observations.cols() < (Eigen::Index)batch_size)
+            _batch_observations.resize(observation_size, _slots.size());
+
+        for(std::size_t i = 0; i < batch_size; i++)
+        {
+            const std::vector<double>& observation =
+                _slots[_batch_slots[i]].episode->get_observation();
+            _batch_observations.col(i) =
+                Eigen::Map<const Eigen::VectorXd>(observation.data(), observation.size());
+        }
+
+        Network::activate_batch(_batch_networks, _batch_columns,
+                                _batch_observations.leftCols(batch_size), _batch_outputs);
+
+        for(std::size_t i = 0; i < batch_size; i++)
+        {
+            std::vector<double>& outputs = _slots[_batch_slots[i]].outputs;
+            outputs.resize(_batch_outputs.rows());
+            Eigen::VectorXd::Map(outputs.data(), outputs.size()) = _batch_outputs.col(i);
+        }
+
+        _batch_networks.clear();
+        _batch_columns.clear();
+        _batch_slots.clear();
+    }
+
+    //Reused between evaluations
+    std::vector<Slot> _slots;
+    std::vector<std::size_t> _waiting;
+    std::vector<Network*> _batch_networks;
+    std::vector<Eigen::Index> _batch_columns;
+    std::vector<std::size_t> _batch_slots;
+    Eigen::MatrixXd _batch_observations;
+    Eigen::MatrixXd _batch_outputs;
+    std::vector<double> _outputs;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
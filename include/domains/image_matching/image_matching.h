@@ -4,9 +4,12 @@
 /*
     The image matching domain constructs a target image for an evolutionary procedure 
     to match. 
+    The target image is also kept packed into words so that images can be compared
+    64 pixels at a time.
 */
 
 #include <domains/domain.h>
+#include <util/bit_vector.h>
 #include <phenotype/phenotype_specs/vector_phenotype_spec.h>
 #include <util/vector_creation/vector_creation_policy.h>
 
@@ -25,18 +28,22 @@ public:
         Domain<G, T>(domain_trace, completion_fitess, std::nullopt, render),
         _vector_creation_policy(vector_creation_policy),
         _image_width(sqrt(vector_creation_policy->get_vector_size())),
-        _target_image(create_target_image(0)) {}
+        _target_image(create_target_image(0)),
+        _target_bits(_target_image->get_vector()) {}
 
-private: 
+protected:
 
     std::shared_ptr<VectorCreationPolicy<bool>> _vector_creation_policy;
 
-protected:
-
     const unsigned _image_width;
     std::optional<Matrix<bool>> _target_image;
+    //Only filled in when rendering
     std::optional<Matrix<bool>> _org_image;
 
+    //Packed target and organism images
+    BitVector _target_bits;
+    BitVector _org_bits;
+
 private:
 
     const Matrix<bool> create_target_image(const unsigned run_num) const
@@ -131,12 +138,8 @@ private:
 
     void determine_winner(Organism<G, T>& org) const
     {
-        for(unsigned i = 0; i < _org_image->get_height(); i++)
-            for(unsigned j = 0; j < _org_image->get_width(); j++)
-                if(_org_image->at(i, j) != _target_image->at(i,j))
-                    return;
-
-        org.set_domain_winner(true);
+        if(_org_bits == _target_bits)
+            org.set_domain_winner(true);
     }
 
 #if SFML_FOUND
@@ -214,13 +217,17 @@ private:
     }
 
     void trial_reset(const unsigned trial_num) override {}
-    void exp_run_reset_impl(const unsigned run_num, const unsigned run_seed) override 
+    void exp_run_reset_impl(const unsigned run_num,
+                            const std::optional<unsigned>& run_seed) override
     {
 
-        if(this->_seed.has_value())
-            _vector_creation_policy->seed(run_seed);
+        //If the vector creation policy does not already have a seed, seed it
+        //with the run seed
+        if(run_seed.has_value() && !_vector_creation_policy->get_seed().has_value())
+            _vector_creation_policy->set_seed(run_seed);
 
         _target_image = create_target_image(run_num);
+        _target_bits.assign(_target_image->get_vector());
 
         /*
         this->set_render(true);
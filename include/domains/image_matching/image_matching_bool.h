@@ -21,20 +21,20 @@ private:
     void extract_org_images(Organism<G, bool>& org) override
     {
         const std::vector<bool> pheno_out = org.get_phenotype().activate();
-        this->_org_image.emplace(this->_image_width, this->_image_width, pheno_out);
+        this->_org_bits.assign(pheno_out);
+
+        if(this->_render)
+            this->_org_image.emplace(this->_image_width, this->_image_width, pheno_out);
     }
 
     double calculate_image_fitness() const override
     {
-        double fitness = 0.;
-
-        //Compare organism guess to target image
-        for(unsigned i = 0; i < this->_org_image->get_height(); i++)
-            for(unsigned j = 0; j < this->_org_image->get_width(); j++)
-                if(this->_org_image->at(i, j) == this->_target_image->at(i, j))
-                    fitness += 1.;
+        //Compare organism guess to target image a word at a time
+        const double num_pixels = this->_image_width * this->_image_width;
+        const double num_matches =
+            num_pixels - this->_org_bits.hamming_distance(this->_target_bits);
 
-        return (fitness / (this->_image_width * this->_image_width));
+        return num_matches / num_pixels;
 
     }
 
@@ -43,6 +43,14 @@ private:
         return new ImageMatchingBool(*this);
     }
 
+    JSON to_json_impl() const override
+    {
+        JSON json;
+        json.emplace("name", "ImageMatchingBool");
+        json.emplace("VectorCreationPolicy", this->_vector_creation_policy->to_json());
+        return json;
+    }
+
 };
 
 } // namespace NeuroEvo
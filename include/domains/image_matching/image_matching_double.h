@@ -23,8 +23,15 @@ private:
         const std::vector<double> pheno_out = org.get_phenotype().activate();
         _org_image_double.emplace(this->_image_width, this->_image_width, pheno_out);
 
+        // Set packed org image too, this is used to determine the winner
+        if(this->_org_bits.size() != pheno_out.size())
+            this->_org_bits = BitVector(pheno_out.size());
+        for(std::size_t i = 0; i < pheno_out.size(); i++)
+            this->_org_bits.set(i, pheno_out[i] > 0.5);
+
         // Set org image bool too this is used to render
-        this->_org_image = cast_matrix_to_bool(_org_image_double.value());
+        if(this->_render)
+            this->_org_image = cast_matrix_to_bool(_org_image_double.value());
         
     }
 
@@ -61,6 +68,14 @@ private:
         return new ImageMatchingDouble(*this);
     }
 
+    JSON to_json_impl() const override
+    {
+        JSON json;
+        json.emplace("name", "ImageMatchingDouble");
+        json.emplace("VectorCreationPolicy", this->_vector_creation_policy->to_json());
+        return json;
+    }
+
     //This is stored in order to calculate the fitness
     std::optional<Matrix<double>> _org_image_double;
 
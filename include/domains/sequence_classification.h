@@ -7,9 +7,19 @@
     and the network must keep track of the overall value.
     This domain is good for testing memory capabilities of
     a network.
+    The sequences of a trial are generated once and kept in a bank, one
+    signed byte per input with every sequence one after the other, that is
+    shared by every organism run on the trial and by copies of the domain.
+    The banks of every trial of a generation are made before its organisms
+    are run and kept until the next generation.
 */
 
 #include <domains/domain.h>
+#include <phenotype/phenotype_specs/network_builder.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <random>
 
 namespace NeuroEvo {
@@ -28,8 +38,9 @@ public:
         _zeros_lower(zeros_lower),
         _zeros_upper(zeros_upper),
         _input_values(std::vector<int>{1, -1}),
-        _rng((std::random_device())()),
-        _zeros_dist(zeros_lower, zeros_upper) {}
+        _zeros_dist(zeros_lower, zeros_upper),
+        _sequence_banks(std::make_shared<SequenceBankCache>()),
+        _inputs(1) {}
 
     bool check_phenotype_spec(const PhenotypeSpec& pheno_spec) const override 
     {
@@ -64,51 +75,88 @@ public:
 
     }
 
+    using Domain<G, double>::evaluate_trials;
+
+    std::vector<double> evaluate_trials(Population<G, double>& pop,
+                                        const std::vector<unsigned>& trial_seeds,
+                                        const std::size_t first_org,
+                                        const std::size_t last_org,
+                                        const std::size_t first_trial,
+                                        const std::size_t last_trial) override
+    {
+        make_sequence_banks(trial_seeds);
+        return Domain<G, double>::evaluate_trials(pop, trial_seeds, first_org,
+                                                  last_org, first_trial, last_trial);
+    }
+
 private:
 
+    //Every sequence of a trial one after the other
+    struct SequenceBank
+    {
+        std::vector<int8_t> values;
+        //Sequence i runs from offsets[i] up to offsets[i + 1]
+        std::vector<std::size_t> offsets;
+
+        std::size_t get_num_sequences() const
+        {
+            return offsets.size() - 1;
+        }
+    };
+
+    //The banks of the trial seeds of the current generation
+    struct SequenceBankCache
+    {
+        std::mutex mutex;
+        std::vector<std::pair<unsigned, std::shared_ptr<const SequenceBank>>> banks;
+    };
+
     double single_run(Organism<G, double>& org, unsigned rand_seed) override 
     {
 
         //Generate sequences of inputs
-        std::vector<std::vector<int> > sequence_inputs = generate_sequences(rand_seed);
+        const std::shared_ptr<const SequenceBank> bank = sequence_bank(rand_seed);
 
         if(this->_domain_trace) 
         {
-            for(const auto& vec : sequence_inputs) 
+            for(std::size_t i = 0; i < bank->get_num_sequences(); i++) 
             {
-                for(const auto& num : vec)
-                    std::cout << num << " ";
+                for(std::size_t j = bank->offsets[i]; j < bank->offsets[i + 1]; j++)
+                    std::cout << (int)bank->values[j] << " ";
                 std::cout << std::endl;
             }
         }
 
+        Phenotype<double>& phenotype = org.get_phenotype();
+
         unsigned num_sequences_correct = 0;
         unsigned num_correct = 0;
 
         //Input sequences into network
-        for(std::size_t i = 0; i < sequence_inputs.size(); i++) 
+        for(std::size_t i = 0; i < bank->get_num_sequences(); i++) 
         {
 
             //Keeps track of input sum in order to calcualte reward
             int sum_so_far = 0;
             unsigned num_correct_this_sequence = 0;
 
-            for(std::size_t j = 0; j < sequence_inputs.at(i).size(); j++) 
+            for(std::size_t j = bank->offsets[i]; j < bank->offsets[i + 1]; j++) 
             {
 
-                std::vector<double> inputs{(double)sequence_inputs.at(i).at(j)};
-                std::vector<double> output = org.get_phenotype().activate(inputs);
-                sum_so_far += sequence_inputs.at(i).at(j);
+                const int input = bank->values[j];
+                _inputs[0] = input;
+                phenotype.activate_into(_inputs, _outputs);
+                sum_so_far += input;
 
-                if(sequence_inputs.at(i).at(j) != 0)
-                    if((sum_so_far >= 0 && output.at(0) >= 0.5) || 
-                       (sum_so_far < 0 && output.at(0) < 0.5))
+                if(input != 0)
+                    if((sum_so_far >= 0 && _outputs[0] >= 0.5) || 
+                       (sum_so_far < 0 && _outputs[0] < 0.5))
                         num_correct_this_sequence += 1;
 
                 if(this->_domain_trace) 
                 {
-                    std::cout << "Input: " << inputs.at(0) << std::endl;
-                    std::cout << "Output: " << output.at(0) << std::endl;
+                    std::cout << "Input: " << _inputs[0] << std::endl;
+                    std::cout << "Output: " << _outputs[0] << std::endl;
                     std::cout << "Sum so far: " << sum_so_far << std::endl;
                     std::cout << std::endl;
                     //std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -126,78 +174,132 @@ private:
             if(this->_domain_trace) std::cout << "---------" <<std::endl;
 
             //Reset the network
-            org.get_phenotype().reset();
+            phenotype.reset();
             num_correct += num_correct_this_sequence;
 
         }
 
         if(this->_domain_trace)
             std::cout << "Num sequences correct: " << num_sequences_correct << "/"
-            << sequence_inputs.size() <<std::endl;
+            << bank->get_num_sequences() <<std::endl;
 
-        return (double)num_correct / (double)(sequence_inputs.size() * _depth);
+        return (double)num_correct / (double)(bank->get_num_sequences() * _depth);
 
         //This might be too sparse a reward to start with
-        //return (double)num_sequences_correct / (double)sequence_inputs.size();
+        //return (double)num_sequences_correct / (double)bank->get_num_sequences();
 
     }
 
-    std::vector<std::vector<int> > generate_sequences(unsigned rand_seed) 
+    //Keeps the banks of trial_seeds only, generating those that are not kept
+    //already. Copies of the domain evaluating other organisms on the same
+    //trials find the banks made.
+    void make_sequence_banks(const std::vector<unsigned>& trial_seeds)
     {
+        std::lock_guard<std::mutex> lock(_sequence_banks->mutex);
 
-        //I think the orginal paper does not get all permutations
-        //I think it only generates a random permutation
-        //Get all permutations of input sequences
-        std::vector<int> empty_vec;
-        std::vector<std::vector<int> > permutations_matrix;
-        get_all_permutations(_input_values, empty_vec, _depth, permutations_matrix);
-
-        std::vector<std::vector<int> > sequences(permutations_matrix.size(), std::vector<int>());
+        auto& banks = _sequence_banks->banks;
+        std::vector<std::pair<unsigned, std::shared_ptr<const SequenceBank>>> trial_banks;
+        trial_banks.reserve(trial_seeds.size());
+        for(const auto trial_seed : trial_seeds)
+            trial_banks.emplace_back(trial_seed, find_sequence_bank(trial_seed));
 
-        for(std::size_t i = 0; i < permutations_matrix.size(); i++) 
-        {
+        for(auto& trial_bank : trial_banks)
+            if(!trial_bank.second)
+                trial_bank.second = generate_sequences(trial_bank.first);
 
-            //Add first element from permutations matrix - will be 1 or -1, no 0 first
-            sequences.at(i).push_back(permutations_matrix.at(i).at(0));
+        banks = std::move(trial_banks);
+    }
 
-            for(std::size_t j = 1; j < permutations_matrix.at(i).size(); j++) 
-            {
-                const unsigned num_zeros = _zeros_dist(_rng);
-                for(unsigned k = 0; k < num_zeros; k++) sequences.at(i).push_back(0);
-                sequences.at(i).push_back(permutations_matrix.at(i).at(j));
-            }
+    //The bank of the trial with rand_seed, which is generated if the trial is
+    //not one of the generation, as for an individual run
+    std::shared_ptr<const SequenceBank> sequence_bank(const unsigned rand_seed)
+    {
+        std::lock_guard<std::mutex> lock(_sequence_banks->mutex);
 
-        }
+        if(auto bank = find_sequence_bank(rand_seed))
+            return bank;
 
-        return sequences;
+        _sequence_banks->banks.emplace_back(rand_seed, generate_sequences(rand_seed));
+        return _sequence_banks->banks.back().second;
+    }
 
+    //Expects the lock of the banks to be held
+    std::shared_ptr<const SequenceBank> find_sequence_bank(const unsigned rand_seed) const
+    {
+        const auto& banks = _sequence_banks->banks;
+        const auto bank = std::find_if(banks.begin(), banks.end(),
+                                       [rand_seed](const auto& b)
+                                       {return b.first == rand_seed;});
+        return bank != banks.end() ? bank->second : nullptr;
     }
 
-    void get_all_permutations(const std::vector<int> values,
-                              std::vector<int> prev_values,
-                              int length,
-                              std::vector<std::vector<int> > &matrix_ref) 
+    std::shared_ptr<const SequenceBank> generate_sequences(const unsigned rand_seed) const
     {
 
-        for(std::vector<int>::const_iterator it = values.begin(); it != values.end(); it++) 
+        //I think the orginal paper does not get all permutations
+        //I think it only generates a random permutation
+        //Every permutation of the input values, in the order of counting in
+        //base _input_values.size() with the first value most significant
+        std::size_t num_sequences = 1;
+        for(unsigned i = 0; i < _depth; i++)
+            num_sequences *= _input_values.size();
+
+        //The zeros are drawn from the trial seed so every organism gets the
+        //same sequences
+        CounterRNG rng(rand_seed);
+        std::uniform_int_distribution<int> zeros_dist = _zeros_dist;
+
+        auto bank = std::make_shared<SequenceBank>();
+        bank->offsets.reserve(num_sequences + 1);
+        bank->values.reserve(num_sequences * (_depth + (_depth - 1) * _zeros_dist.b()));
+
+        std::vector<std::size_t> digits(_depth);
+
+        for(std::size_t i = 0; i < num_sequences; i++) 
         {
-            std::vector<int> new_vec;
 
-            new_vec.insert(new_vec.end(), prev_values.begin(), prev_values.end());
-            new_vec.insert(new_vec.end(), it, it+1);
+            std::size_t remainder = i;
+            for(unsigned j = _depth; j-- > 0;)
+            {
+                digits[j] = remainder % _input_values.size();
+                remainder /= _input_values.size();
+            }
+
+            bank->offsets.push_back(bank->values.size());
+
+            //First element will be 1 or -1, no 0 first
+            bank->values.push_back(_input_values[digits[0]]);
+
+            for(unsigned j = 1; j < _depth; j++) 
+            {
+                const unsigned num_zeros = zeros_dist(rng);
+                bank->values.insert(bank->values.end(), num_zeros, 0);
+                bank->values.push_back(_input_values[digits[j]]);
+            }
 
-            if(length == 1)
-                matrix_ref.push_back(new_vec);
-            else
-                get_all_permutations(values, new_vec, length-1, matrix_ref);
         }
 
+        bank->offsets.push_back(bank->values.size());
+
+        return bank;
+
     }
 
     void render() override {}
-    void exp_run_reset_impl(const unsigned run_num, const unsigned run_seed) override {}
+    void exp_run_reset_impl(const unsigned run_num,
+                            const std::optional<unsigned>& run_seed) override {}
     void trial_reset(const unsigned trial_num) override {}
 
+    JSON to_json_impl() const override
+    {
+        JSON json;
+        json.emplace("name", "SequenceClassification");
+        json.emplace("depth", _depth);
+        json.emplace("zeros_lower", _zeros_lower);
+        json.emplace("zeros_upper", _zeros_upper);
+        return json;
+    }
+
     SequenceClassification* clone_impl() const override
     {
         return new SequenceClassification(*this);
@@ -209,10 +311,14 @@ private:
 
     const std::vector<int> _input_values;
 
-    //Random number generators
-    std::mt19937 _rng;
     std::uniform_int_distribution<int> _zeros_dist;
 
+    //Shared by copies of the domain
+    std::shared_ptr<SequenceBankCache> _sequence_banks;
+
+    std::vector<double> _inputs;
+    std::vector<double> _outputs;
+
 };
 
 } // namespace NeuroEvo
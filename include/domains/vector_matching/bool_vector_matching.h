@@ -1,7 +1,13 @@
 #ifndef _BOOL_VECTOR_MATCHING_
 #define _BOOL_VECTOR_MATCHING_
 
+/*
+ * The matching vector is packed into words so that the number of matches is
+ * counted 64 traits at a time
+ */
+
 #include <domains/vector_matching/vector_matching.h>
+#include <util/bit_vector.h>
 
 namespace NeuroEvo {
 
@@ -14,7 +20,8 @@ public:
     BoolVectorMatching(const std::vector<bool>& matching_vector,
                        const bool domain_trace = false,
                        const double completion_fitness = 1.) :
-        VectorMatching<G, bool>(matching_vector, domain_trace, completion_fitness) {}
+        VectorMatching<G, bool>(matching_vector, domain_trace, completion_fitness),
+        _matching_bits(matching_vector) {}
 
     //If a matching vector is not given then one is randomly generated
     //according to a distribution
@@ -32,22 +39,19 @@ private:
         const std::vector<bool> phenotype_vector = 
             org.get_phenotype().activate(std::vector<double>());
 
-        unsigned num_matches = 0;
-
-        for(std::size_t i = 0; i < phenotype_vector.size(); i++)
-        {
-            if(this->_domain_trace)
-                std::cout << this->_matching_vector[i] << " " << phenotype_vector[i] << " ";
-
-            if(this->_matching_vector[i] == phenotype_vector[i])
+        if(this->_domain_trace)
+            for(std::size_t i = 0; i < phenotype_vector.size(); i++)
             {
-                num_matches += 1;
-                if(this->_domain_trace) std::cout << "Match!" << std::endl;
-
-            } else
-                if(this->_domain_trace) std::cout << "No match" << std::endl;
+                std::cout << this->_matching_vector[i] << " " << phenotype_vector[i] << " ";
+                if(this->_matching_vector[i] == phenotype_vector[i])
+                    std::cout << "Match!" << std::endl;
+                else
+                    std::cout << "No match" << std::endl;
+            }
 
-        }
+        const BitVector phenotype_bits(phenotype_vector);
+        const std::size_t num_matches =
+            phenotype_bits.size() - phenotype_bits.hamming_distance(_matching_bits);
 
         const double match_value = (double)num_matches / (double)phenotype_vector.size(); 
 
@@ -60,11 +64,29 @@ private:
         return match_value;
     }
 
+    void matching_vector_changed() override
+    {
+        _matching_bits.assign(this->_matching_vector);
+    }
+
     BoolVectorMatching* clone_impl() const override
     {
         return new BoolVectorMatching(*this);
     }
 
+    JSON to_json_impl() const override
+    {
+        JSON json;
+        json.emplace("name", "BoolVectorMatching");
+        json.emplace("matching_vector", this->_matching_vector);
+        if(this->_vector_creation_policy)
+            json.emplace("VectorCreationPolicy",
+                         this->_vector_creation_policy->to_json());
+        return json;
+    }
+
+    BitVector _matching_bits;
+
 };
 
 } // namespace NeuroEvo
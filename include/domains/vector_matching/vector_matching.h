@@ -81,6 +81,8 @@ protected:
     //Calculates how closely the phenotype vector matches the matching vector
     //This is calculated differently depending on the trait type
     virtual double calculate_match_value(Organism<G, T>& org) const = 0;
+    //Called whenever a new matching vector is generated
+    virtual void matching_vector_changed() {}
     void render() override {}
 
     void print_matching_vector() const
@@ -98,9 +100,6 @@ private:
 
     double single_run(Organism<G, T>& org, unsigned rand_seed) override
     {
-        const std::vector<T> phenotype_vector =
-            org.get_phenotype().activate(std::vector<double>());
-
         const double fitness = calculate_match_value(org);
 
         return fitness;
@@ -119,7 +118,10 @@ private:
 
             //Generate matching vector
             if(run_seed.has_value())
+            {
                 _matching_vector = _vector_creation_policy->generate_vector(run_num);
+                matching_vector_changed();
+            }
 
             print_matching_vector();
         }
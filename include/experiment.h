@@ -53,6 +53,14 @@ public:
 
         std::clock_t start = std::clock();
 
+        //All runs share one pool to evaluate organisms on the domains in
+        //parallel, it is given to a copy so the caller's optimiser is unchanged
+        if(domain_parallel)
+        {
+            optimiser = optimiser->clone();
+            optimiser->set_thread_pool(std::make_shared<ThreadPool>());
+        }
+
         if(_dump_data)
         {
             //Create experiment directory
@@ -73,8 +81,7 @@ public:
             const RunArguments<G, T> run_args{
                 _domains, optimiser, _gp_map,
                 _exp_dir_path, _dump_winners_only,
-                _num_winners, _total_winners_gens, trace,
-                domain_parallel};
+                _num_winners, _total_winners_gens, trace};
             RunScheduler<G, T> scheduler(run_args, num_runs);
             scheduler.dispatch(run);
 
@@ -87,8 +94,7 @@ public:
                 std::cout << "Starting run: " << i << std::endl;
                 run(_domains, optimiser, _gp_map, i, _exp_dir_path,
                     _dump_winners_only,
-                    _num_winners, completed_flag, _total_winners_gens, trace,
-                    domain_parallel);
+                    _num_winners, completed_flag, _total_winners_gens, trace);
             }
         }
 
@@ -160,8 +166,7 @@ private:
                     unsigned& num_winners,
                     bool& completed_flag,
                     unsigned& total_winners_gens,
-                    const bool trace = true,
-                    const bool domain_parallel = false)
+                    const bool trace = true)
     {
 
         //Copy and reset domains
@@ -175,12 +180,16 @@ private:
         std::unique_ptr<Optimiser<G, T>> optimiser = a_optimiser->clone();
         optimiser->reset();
 
+        //Organisms share their GPMap so each run, which may be on its own thread,
+        //needs its own copy
+        std::shared_ptr<GPMap<G, T>> gp_map = m_gp_map->clone();
+
         //Create new data collector
         DataCollector<G, T> data_collector(exp_dir_path, optimiser->get_max_gens(),
                                            dump_winners_only, trace);
 
         //Call optimiser
-        const bool optimiser_status = optimiser->optimise(domains, m_gp_map,
+        const bool optimiser_status = optimiser->optimise(domains, gp_map,
                                                           data_collector);
 
         // Check whether the domain was solved or not
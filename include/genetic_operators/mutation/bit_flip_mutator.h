@@ -1,6 +1,15 @@
 #ifndef _BIT_FLIP_MUTATOR_H_
 #define _BIT_FLIP_MUTATOR_H_
 
+/*
+ * Flips each bit with probability equal to the mutation rate.
+ * Genes are mutated a word at a time by XORing them with random masks in which
+ * each bit is set with the mutation rate. A mask is built from a few random
+ * words combined according to the binary expansion of the mutation rate.
+ * When the mutation rate is low enough that this costs more than skipping
+ * straight to each mutated bit, skip sampling is used instead.
+ */
+
 #include <genetic_operators/mutation/mutator.h>
 
 namespace NeuroEvo {
@@ -10,19 +19,35 @@ class BitFlipMutator : public Mutator<bool>
 
 public:
 
-    BitFlipMutator(const double mutation_rate);
+    BitFlipMutator(const double mutation_rate, const bool skip_sampling = true);
 
-    void mutate(std::vector<bool>& genes) override;
+    void mutate(BitVector& genes) override;
 
 private:
 
-    void reset_mutator(const std::optional<unsigned>& seed) override {};
+    //A random word in which each bit is 1 with probability equal to the
+    //mutation rate
+    BitVector::word_type random_mask();
+
+    BitVector::word_type random_word()
+    {
+        return (static_cast<BitVector::word_type>(_mask_rng()) << 32) | _mask_rng();
+    }
+
+    void reset_mutator(const std::optional<unsigned>& seed) override;
 
     BitFlipMutator* clone_impl() const override
     {
         return new BitFlipMutator(*this);
     }
 
+    //Mutation rate as a 32-bit fixed point fraction
+    std::uint64_t _fixed_point_rate;
+    //Number of random words combined to build each mask
+    unsigned _mask_rounds;
+
+    CounterRNG _mask_rng;
+
 };
 
 } // namespace NeuroEvo
@@ -17,12 +17,20 @@ class CharMutator : public Mutator<char>
 public:
 
     CharMutator(const double mutation_rate, const std::set<char>& char_set,
-                const std::optional<std::vector<double>>& char_distr = std::nullopt);
+                const std::optional<std::vector<double>>& char_distr = std::nullopt,
+                const bool skip_sampling = true);
 
     void mutate(std::vector<char>& genes) override;
 
 private:
 
+    void reset_mutator(const std::optional<unsigned>& seed) override;
+
+    CharMutator* clone_impl() const override
+    {
+        return new CharMutator(*this);
+    }
+
     CharDistribution _char_distr;
 
 };
@@ -7,8 +7,11 @@
  * type in a particular way.
  */
 
+#include <genotype/genes.h>
 #include <util/statistics/distributions/uniform_real_distribution.h>
 #include <util/factory.h>
+#include <cmath>
+#include <limits>
 
 namespace NeuroEvo {
 
@@ -17,13 +20,18 @@ class Mutator {
 
 public:
 
-    Mutator(const double mutation_rate) :
+    //If skip sampling is on, the number of genes to skip until the next mutation
+    //is drawn from a geometric distribution rather than drawing a random number
+    //for every gene. Both give the same distribution of mutations.
+    Mutator(const double mutation_rate, const bool skip_sampling = true) :
         _mutation_rate(mutation_rate),
-        _mutation_distr(0., 1.) {}
+        _mutation_distr(0., 1.),
+        _skip_sampling(skip_sampling),
+        _log_no_mutation_prob(std::log1p(-mutation_rate)) {}
 
     virtual ~Mutator() = default;
 
-    virtual void mutate(std::vector<G>& genes) = 0;
+    virtual void mutate(Genes<G>& genes) = 0;
 
     auto clone() const
     {
@@ -52,11 +60,50 @@ protected:
     //whether a gene should mutate or not
     UniformRealDistribution _mutation_distr;
 
+    const bool _skip_sampling;
+
     //Determines whether gene should mutate
     bool should_mutate() {
         return _mutation_distr.next() < _mutation_rate;
     }
 
+    //Calls mutate_gene with the index of every gene chosen for mutation
+    template <typename F>
+    void for_each_mutated_gene(const std::size_t num_genes, F&& mutate_gene)
+    {
+        if(_skip_sampling)
+        {
+            for(std::size_t i = genes_to_skip(num_genes); i < num_genes;
+                i += 1 + genes_to_skip(num_genes))
+                mutate_gene(i);
+        }
+        else
+            for(std::size_t i = 0; i < num_genes; i++)
+                if(should_mutate())
+                    mutate_gene(i);
+    }
+
+private:
+
+    //Number of genes that are not mutated before the next mutated gene,
+    //capped at max_skip
+    std::size_t genes_to_skip(const std::size_t max_skip)
+    {
+        if(_mutation_rate >= 1.)
+            return 0;
+        if(_mutation_rate <= 0.)
+            return max_skip;
+
+        const double skip = std::floor(std::log1p(-_mutation_distr.next()) /
+                                       _log_no_mutation_prob);
+        if(skip >= static_cast<double>(max_skip))
+            return max_skip;
+        return static_cast<std::size_t>(skip);
+    }
+
+    //log(1 - mutation rate)
+    const double _log_no_mutation_prob;
+
 };
 
 } // namespace NeuroEvo
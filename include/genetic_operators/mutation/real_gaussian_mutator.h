@@ -14,7 +14,8 @@ public:
         const double mutation_rate,
         const double mutation_power,
         const std::optional<const double> lower_bound = std::nullopt,
-        const std::optional<const double> upper_bound = std::nullopt);
+        const std::optional<const double> upper_bound = std::nullopt,
+        const bool skip_sampling = true);
 
     //A vector of bounds can be given such that each individual gene has a different
     //set of bounds
@@ -22,7 +23,8 @@ public:
     //will be thrown when trying to mutate
     RealGaussianMutator(const double mutation_rate, const double mutation_power,
                         const std::vector<double>& lower_bounds,
-                        const std::vector<double>& upper_bounds);
+                        const std::vector<double>& upper_bounds,
+                        const bool skip_sampling = true);
 
     RealGaussianMutator(const JSON& json);
 
@@ -32,6 +34,9 @@ private:
 
     void reset_mutator(const std::optional<unsigned>& seed) override;
 
+    //Applies the bounds to the genes that were mutated
+    void clamp_mutated_genes(std::vector<double>& genes) const;
+
     RealGaussianMutator* clone_impl() const override
     {
         return new RealGaussianMutator(*this);
@@ -50,6 +55,9 @@ private:
     const std::optional<const std::vector<double>> _lower_bounds;
     const std::optional<const std::vector<double>> _upper_bounds;
 
+    //Indices of the genes mutated in the last call to mutate
+    std::vector<std::size_t> _mutated_genes;
+
 };
 
 
@@ -7,9 +7,13 @@
     all the fitness to above 0. This creates slight problems in
     that the lowest fitness organism gets 0% of the 'pie'. One can
     include a bias term to give it some proportion of the selection.
+
+    The wheel is built as an alias table once per call so that drawing
+    each parent is O(1).
 */
 
 #include <genetic_operators/selection/selection.h>
+#include <util/statistics/alias_table.h>
 #include <random>
 
 namespace NeuroEvo {
@@ -24,77 +28,53 @@ public:
         _uniform_distr(0., 1.) {}
 
     //Selects genome according to roulette wheel selection
-    Organism<G, T> select(const std::vector<Organism<G, T>>& orgs) override 
+    Organism<G, T> select(const std::vector<Organism<G, T>>& orgs) override
     {
-        
-        //Scale fitnesses
-        std::vector<double> scaled_fitnesses = scale_fitnesses(orgs);
-
-        double total_fitness = calculate_total_pop_fitness(scaled_fitnesses);
-
-        double fitness_so_far = 0.0;
-        double rand_num = _uniform_distr.next();
-
-        unsigned chosen_org = 0;
-
-        for(size_t i = 0; i < scaled_fitnesses.size(); i++) {
-
-            fitness_so_far += scaled_fitnesses.at(i) / total_fitness;
-
-            if(rand_num < fitness_so_far) {
+        build_wheel(orgs);
 
-                chosen_org = i;
-                break;
-
-            }
+        //The child starts unevaluated, only the genes are inherited
+        const Organism<G, T>& parent = orgs[_wheel.sample(_uniform_distr.next())];
+        return Organism<G, T>(parent.get_genotype(), parent.get_shared_gp_map());
+    }
 
-        }
+    //Spins the same wheel num_parents times
+    std::vector<std::size_t> select_parents(const std::vector<Organism<G, T>>& orgs,
+                                            const unsigned num_parents) override
+    {
+        build_wheel(orgs);
 
-        return Organism(orgs.at(chosen_org).get_genotype(),
-                        orgs.at(chosen_org).get_gp_map());
+        std::vector<std::size_t> parents(num_parents);
+        for(auto& parent : parents)
+            parent = _wheel.sample(_uniform_distr.next());
 
+        return parents;
     }
 
 private:
 
-    std::vector<double> scale_fitnesses(const std::vector<Organism<G, T>>& orgs) 
+    void build_wheel(const std::vector<Organism<G, T>>& orgs)
     {
+        scale_fitnesses(orgs);
+        _wheel.build(_scaled_fitnesses);
+    }
 
-        //Find smallest fitness
-        double smallest_fitness;
-
-        for(size_t i = 0; i < orgs.size(); i++) {
-
-            if(i==0)
-                smallest_fitness = orgs.at(i).get_fitness().value();
-            else
-                if(orgs.at(i).get_fitness().value() < smallest_fitness)
-                    smallest_fitness = orgs.at(i).get_fitness().value();
+    void scale_fitnesses(const std::vector<Organism<G, T>>& orgs)
+    {
+        _scaled_fitnesses.resize(orgs.size());
 
+        //Find smallest fitness
+        double smallest_fitness = orgs[0].get_fitness().value();
+        for(std::size_t i = 0; i < orgs.size(); i++)
+        {
+            _scaled_fitnesses[i] = orgs[i].get_fitness().value();
+            if(_scaled_fitnesses[i] < smallest_fitness)
+                smallest_fitness = _scaled_fitnesses[i];
         }
 
         //Scale fitnesses by adding (-1)*smallest_fitness to every value
         //and a bias value so there is never a 0 fitness
-        std::vector<double> scaled_fitnesses(orgs.size());
-
-        for(size_t i = 0; i < orgs.size(); i++)
-            scaled_fitnesses.at(i) = -smallest_fitness + orgs.at(i).get_fitness().value() 
-                                     + _bias;
-
-        return scaled_fitnesses;
-
-    }
-
-    double calculate_total_pop_fitness(std::vector<double>& fitnesses) 
-    {
-
-        double total_fitness = 0.0;
-
-        for(size_t i = 0; i < fitnesses.size(); i++)
-            total_fitness += fitnesses.at(i);
-
-        return total_fitness;
-
+        for(auto& fitness : _scaled_fitnesses)
+            fitness += -smallest_fitness + _bias;
     }
 
     RouletteWheelSelection* clone_impl() const override
@@ -116,6 +96,10 @@ private:
     //RNG
     UniformRealDistribution _uniform_distr;
 
+    //Storage reused between generations
+    std::vector<double> _scaled_fitnesses;
+    AliasTable _wheel;
+
 };
 
 } // namespace NeuroEvo
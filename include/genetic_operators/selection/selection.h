@@ -17,6 +17,12 @@ public:
     // modifications can be applied.
     virtual Organism<G, T> select(const std::vector<Organism<G, T>>& orgs) = 0;
 
+    // Selects the indices of num_parents parents from a population in one go.
+    // Any per-generation preprocessing of the population is only done once.
+    virtual std::vector<std::size_t> select_parents(
+        const std::vector<Organism<G, T>>& orgs,
+        const unsigned num_parents) = 0;
+
     auto clone() const 
     {
         return std::unique_ptr<Selection>(clone_impl());
@@ -49,6 +49,26 @@ public:
 
     }
 
+    std::vector<std::size_t> select_parents(const std::vector<Organism<G, T>>& orgs,
+                                            const unsigned num_parents) override
+    {
+
+        // Sort once for the whole generation
+        std::vector<unsigned> sorted_pop_indices = sort_population(orgs);
+
+        unsigned num_orgs_considered = floor(_percentage_selection * orgs.size());
+        if(num_orgs_considered < 1)
+            num_orgs_considered = 1;
+
+        std::vector<std::size_t> parents(num_parents);
+        for(auto& parent : parents)
+            parent = sorted_pop_indices[
+                floor(_uniform_distr.next() * num_orgs_considered)];
+
+        return parents;
+
+    }
+
 private:
 
     std::vector<unsigned> sort_population(const std::vector<Organism<G, T>>& orgs) 
@@ -0,0 +1,32 @@
+#ifndef _GENES_H_
+#define _GENES_H_
+
+/*
+ * The container that a genotype stores its genes in.
+ * Genes are stored in a std::vector apart from boolean genes which are packed
+ * into 64-bit words so that they can be mutated and read a word at a time.
+ */
+
+#include <vector>
+#include <util/bit_vector.h>
+
+namespace NeuroEvo {
+
+template <typename G>
+struct GeneContainer
+{
+    typedef std::vector<G> type;
+};
+
+template <>
+struct GeneContainer<bool>
+{
+    typedef BitVector type;
+};
+
+template <typename G>
+using Genes = typename GeneContainer<G>::type;
+
+} // namespace NeuroEvo
+
+#endif
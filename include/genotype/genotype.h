@@ -3,14 +3,17 @@
 
 /*
  * A genotype is a vector of templated values that can be mutated according to some mutator
+ * Boolean genes are bit-packed, see genes.h
  */
 
 #include <vector>
+#include <genotype/genes.h>
 #include <iostream>
 #include <genetic_operators/mutation/mutator.h>
 #include <memory>
 #include <fstream>
 #include <sstream>
+#include <type_traits>
 #include <data/json.h>
 
 namespace NeuroEvo {
@@ -32,18 +35,22 @@ public:
         _fitness(fitness),
         _genes(genes) {}
 
+    //Only needed when the gene container is not a std::vector
+    Genotype(const Genes<G>& genes) requires (!std::is_same_v<Genes<G>, std::vector<G>>) :
+        _genes(genes) {}
+
     auto clone() const
     {
         return std::unique_ptr<Genotype<G>>(new Genotype<G>(*this));
     }
 
-    const std::vector<G>& genes() const
+    const Genes<G>& genes() const
     {
         return _genes;
     }
 
     // Mutable reference to genes
-    std::vector<G>& genes_mut()
+    Genes<G>& genes_mut()
     {
         return _genes;
     }
@@ -56,7 +63,10 @@ public:
     JSON to_json() const
     {
         JSON json;
-        json.emplace("genes", _genes);
+        if constexpr(std::is_same_v<Genes<G>, std::vector<G>>)
+            json.emplace("genes", _genes);
+        else
+            json.emplace("genes", std::vector<G>(_genes.begin(), _genes.end()));
         return json;
     }
 
@@ -90,7 +100,7 @@ private:
     //doing.
     std::optional<double> _fitness;
 
-    std::vector<G> _genes;
+    Genes<G> _genes;
 
 };
 
@@ -25,7 +25,7 @@ public:
            const unsigned inputs_per_neuron, std::shared_ptr<NetworkBuilder> net_builder);
 
     // Perform DCTIII (inverse DCTII) on genotype
-    Phenotype<double>* map(Genotype<double>& genotype) override;
+    Phenotype<double>* map(const Genotype<double>& genotype) const override;
 
     void print(std::ostream& os) const override {};
 
@@ -35,7 +35,7 @@ private:
     const unsigned _num_neurons;
     const unsigned _inputs_per_neuron;
 
-    void remove_higher_frequencies(Matrix<double>& coefficients);
+    void remove_higher_frequencies(Matrix<double>& coefficients) const;
 
     JSON to_json_impl() const override;
 
@@ -30,7 +30,18 @@ public:
 
     virtual ~GPMap() = default;
 
-    virtual Phenotype<T>* map(Genotype<G>& genotype) = 0;
+    //Mapping must not change the map, so that one map can be shared by many
+    //organisms and called from several threads at once
+    virtual Phenotype<T>* map(const Genotype<G>& genotype) const = 0;
+
+    //Maps the genotype into an existing phenotype.
+    //Maps whose phenotypes can be rewritten in place should override this so
+    //that no new phenotype has to be allocated.
+    virtual void remap(const Genotype<G>& genotype,
+                       std::unique_ptr<Phenotype<T>>& phenotype) const
+    {
+        phenotype.reset(map(genotype));
+    }
 
     const std::shared_ptr<PhenotypeSpec>& get_pheno_spec() const
     {
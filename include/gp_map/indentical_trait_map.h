@@ -20,7 +20,7 @@ public:
     IdenticalTraitMap(const VectorPhenotypeSpec* pheno_spec) :
         GPMap<G, G>(pheno_spec) {}
 
-    Phenotype<G>* map(Genotype<G>& genotype) override {
+    Phenotype<G>* map(const Genotype<G>& genotype) const override {
 
        const G first_gene = genotype.genes().at(0); 
 
@@ -26,7 +26,7 @@ public:
               std::shared_ptr<PhenotypeSpec> pheno_spec);
     MatrixMap(const std::string& file_name, std::shared_ptr<PhenotypeSpec> pheno_spec);
 
-    Phenotype<double>* map(Genotype<double>& genotype) override;
+    Phenotype<double>* map(const Genotype<double>& genotype) const override;
 
     void print(std::ostream& os) const override;
 
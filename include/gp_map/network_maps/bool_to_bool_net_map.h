@@ -19,7 +19,7 @@ public:
     BoolToBoolNetMap(NetworkBuilder& decoder_spec,
                      std::shared_ptr<VectorPhenotypeSpec> pheno_spec);
 
-    Phenotype<bool>* map(Genotype<bool>& genotype) override;
+    Phenotype<bool>* map(const Genotype<bool>& genotype) const override;
 
 private:
 
@@ -19,7 +19,7 @@ public:
     DoubleToBoolNetMap(NetworkBuilder& decoder_spec,
                        std::shared_ptr<VectorPhenotypeSpec> pheno_spec);
 
-    Phenotype<bool>* map(Genotype<double>& genotype) override;
+    Phenotype<bool>* map(const Genotype<double>& genotype) const override;
 
 private:
 
@@ -20,7 +20,7 @@ public:
                          std::shared_ptr<VectorPhenotypeSpec> pheno_spec);
     DoubleToDoubleNetMap(const JSON& json);
 
-    Phenotype<double>* map(Genotype<double>& genotype) override;
+    Phenotype<double>* map(const Genotype<double>& genotype) const override;
 
 private:
 
@@ -18,7 +18,7 @@ public:
     DoubleToNetworkNetMap(NetworkBuilder& decoder_spec,
                           std::shared_ptr<NetworkBuilder> pheno_spec);
 
-    Phenotype<double>* map(Genotype<double>& genotype) override;
+    Phenotype<double>* map(const Genotype<double>& genotype) const override;
 
 private:
 
@@ -6,11 +6,14 @@
 #include <phenotype/neural_network/network.h>
 #include <sstream>
 #include <iterator>
+#include <util/concurrency/clone_pool.h>
 
 /*
  * A network map passes the genotype through a network
  * and the outputs of that network are used to build
  * the phenotype.
+ * Activating a network changes its state, so each thread mapping at the same
+ * time borrows its own copy of the decoder.
  */
 
 namespace NeuroEvo {
@@ -24,17 +27,20 @@ public:
     NetworkMap(NetworkBuilder& decoder_spec,
                std::shared_ptr<PhenotypeSpec> pheno_spec) :
         GPMap<G, T>(pheno_spec),
-        _decoder(decoder_spec.build_network()) {}
+        _decoder(decoder_spec.build_network()),
+        _decoders([this]() {return _decoder->clone_phenotype();}) {}
 
     NetworkMap(const JSON& json) :
         GPMap<G, T>(Factory<PhenotypeSpec>::create(json.at({"PhenotypeSpec"}))),
-        _decoder(NetworkBuilder(json.at({"NetworkBuilder"})).build_network()) {}
+        _decoder(NetworkBuilder(json.at({"NetworkBuilder"})).build_network()),
+        _decoders([this]() {return _decoder->clone_phenotype();}) {}
 
     NetworkMap(const NetworkMap& network_map) :
         GPMap<G, T>(network_map),
-        _decoder(network_map._decoder->clone_phenotype()) {}
+        _decoder(network_map._decoder->clone_phenotype()),
+        _decoders([this]() {return _decoder->clone_phenotype();}) {}
 
-    Phenotype<T>* map(Genotype<G>& genotype) override = 0;
+    Phenotype<T>* map(const Genotype<G>& genotype) const override = 0;
 
     void print(std::ostream& os) const override
     {
@@ -50,8 +56,19 @@ protected:
 
     NetworkMap* clone_impl() const override = 0;
 
+    //Passes the inputs through a decoder that no other thread is using
+    std::vector<double> decode(const std::vector<double>& inputs) const
+    {
+        return _decoders.borrow()->activate(inputs);
+    }
+
+    //The decoder all other decoders are copied from, it is never activated
     std::unique_ptr<Phenotype<double>> _decoder;
 
+private:
+
+    mutable ClonePool<Phenotype<double>> _decoders;
+
 };
 
 } // namespace NeuroEvo
@@ -17,7 +17,7 @@ public:
 
     DoubleToBoolVectorMap(std::shared_ptr<VectorPhenotypeSpec> pheno_spec);
 
-    Phenotype<bool>* map(Genotype<double>& genotype) override;
+    Phenotype<bool>* map(const Genotype<double>& genotype) const override;
 
     void print(std::ostream& os) const override {}
 
@@ -24,12 +24,24 @@ public:
         VectorMap(
             std::make_shared<VectorPhenotypeSpec>(JSON(json.at({"PhenotypeSpec"})))) {}
 
-    Phenotype<G>* map(Genotype<G>& genotype) override
+    Phenotype<G>* map(const Genotype<G>& genotype) const override
     {
         const std::vector<G> traits(genotype.genes().begin(), genotype.genes().end());
         return new VectorPhenotype<G>(traits);
     }
 
+    void remap(const Genotype<G>& genotype,
+               std::unique_ptr<Phenotype<G>>& phenotype) const override
+    {
+        auto vector_phenotype = dynamic_cast<VectorPhenotype<G>*>(phenotype.get());
+
+        if(vector_phenotype == nullptr)
+            phenotype.reset(map(genotype));
+        else
+            vector_phenotype->assign_traits(genotype.genes().begin(),
+                                            genotype.genes().end());
+    }
+
     void print(std::ostream& os) const override {}
 
 private:
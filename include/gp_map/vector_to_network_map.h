@@ -18,7 +18,7 @@ public:
     VectorToNetworkMap(std::shared_ptr<NetworkBuilder> net_builder);
     VectorToNetworkMap(const JSON& json);
 
-    Phenotype<double>* map(Genotype<double>& genotype) override;
+    Phenotype<double>* map(const Genotype<double>& genotype) const override;
 
     void print(std::ostream& os) const override {}
 
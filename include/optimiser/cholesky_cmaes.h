@@ -0,0 +1,283 @@
+#ifndef _CHOLESKY_CMAES_H_
+#define _CHOLESKY_CMAES_H_
+
+/*
+    Cholesky CMA-ES (Suttorp, Hansen & Igel 2009, Krause et al. 2016).
+    Rather than periodically eigendecomposing the covariance matrix, a factor A
+    with C = A * A^T and its inverse are maintained directly. Every term of the
+    covariance update is applied to A and A^(-1) as a rank-one update in O(N^2),
+    so a generation costs O(mu N^2) and there are no O(N^3) spikes.
+*/
+
+#include <optimiser/optimiser.h>
+#include <util/statistics/distributions/gaussian_distribution.h>
+
+#include <Eigen/Dense>
+
+namespace NeuroEvo {
+
+template <typename T>
+class CholeskyCMAES : public Optimiser<double, T>
+{
+
+public:
+
+    CholeskyCMAES(std::vector<double> init_mean,
+                  double init_sigma,
+                  const unsigned num_genes,
+                  const unsigned max_gens,
+                  const unsigned pop_size,
+                  const bool quit_when_domain_complete = true,
+                  const unsigned num_trials = 1,
+                  const std::optional<unsigned>& seed = std::nullopt) :
+        Optimiser<double, T>(num_genes, max_gens, pop_size, quit_when_domain_complete,
+                             num_trials, seed),
+        _mean(Eigen::VectorXd::Zero(this->_num_genes)),
+        _mean_old(Eigen::VectorXd::Zero(this->_num_genes)),
+        _sigma(init_sigma),
+        _A(Eigen::MatrixXd::Identity(this->_num_genes, this->_num_genes)),
+        _invA(Eigen::MatrixXd::Identity(this->_num_genes, this->_num_genes)),
+        _p_c(Eigen::VectorXd::Zero(this->_num_genes)),
+        _p_sigma(Eigen::VectorXd::Zero(this->_num_genes)),
+        _count_eval(0),
+        _samples(Eigen::MatrixXd::Zero(this->_num_genes, this->_pop_size)),
+        _gauss_distr(0, 1)
+    {
+
+        //If only one element is given in initial mean vector, assume that this value
+        //is to be repeated for all genes
+        if(init_mean.size() == 1)
+            init_mean = std::vector<double>(num_genes, init_mean.at(0));
+
+        if(init_mean.size() != this->_num_genes)
+            throw std::length_error("Initial mean vector to CholeskyCMAES is not the "
+                                    "same size as number of genes");
+
+        _mean = Eigen::Map<const Eigen::VectorXd>(init_mean.data(), init_mean.size());
+
+        //Initialise constants
+        _mu = pop_size / 2;
+        _weights = calculate_weights();
+        _elites = Eigen::MatrixXd::Zero(this->_num_genes, _mu);
+        _mu_eff = 1. / (_weights.transpose() * _weights);
+
+        _N = static_cast<double>(this->_num_genes);
+        _lambda = static_cast<double>(this->_pop_size);
+
+        _c_c = (4. + _mu_eff / _N) / (_N + 4. + 2. * _mu_eff / _N);
+        _c_sig = (_mu_eff + 2.) / (_N + _mu_eff + 5.);
+        const double alpha_cov = 2.;
+        _c_1 = alpha_cov / ((_N + 1.3) * (_N + 1.3) + _mu_eff);
+        _c_mu = std::min(1 - _c_1,
+                         alpha_cov * (_mu_eff -2. + 1. / _mu_eff) /
+                                     ((_N + 2.) * (_N + 2.) + alpha_cov *
+                                      _mu_eff / 2.));
+
+        _d_sig = 1. + 2. * std::max(0., std::sqrt((_mu_eff - 1.) / (_N + 1.)) - 1.) +
+                 _c_sig;
+        //Expectation of ||N(0,I)|| == norm(randn(N,1))
+        _chiN = std::sqrt(_N) * (1. - 1. / (4. * _N) + 1. / (21. * _N * _N));
+
+    }
+
+    CholeskyCMAES(const JSON& json) :
+        CholeskyCMAES(json.at({"init_mean"}),
+                      json.at({"init_sigma"}),
+                      json.at({"num_genes"}),
+                      json.at({"num_gens"}),
+                      json.at({"pop_size"}),
+                      json.at({"quit_domain_when_complete"}),
+                      json.at({"num_trials"})) {}
+
+    Population<double, T> step(std::shared_ptr<GPMap<double, T>> gp_map) override
+    {
+
+        _count_eval += this->_pop_size;
+
+        //Sort population on the contiguous fitnesses
+        const std::vector<double>& fitnesses = this->_population.get_fitnesses();
+        std::vector<std::size_t> sorted_pop_indices(this->_pop_size);
+        std::iota(sorted_pop_indices.begin(), sorted_pop_indices.end(), 0);
+        std::partial_sort(sorted_pop_indices.begin(), sorted_pop_indices.begin() + _mu,
+                          sorted_pop_indices.end(),
+                          [&fitnesses](std::size_t i, std::size_t j)
+                          {
+                              return fitnesses[i] > fitnesses[j];
+                          });
+
+        //Place elite genomes into the columns of an N x mu matrix, straight from
+        //the rows of the gene matrix of the population
+        const std::vector<double>& genes = this->_population.get_genes();
+        for(unsigned i = 0; i < _mu; i++)
+            _elites.col(i) = Eigen::Map<const Eigen::VectorXd>(
+                genes.data() + sorted_pop_indices[i] * this->_num_genes,
+                this->_num_genes);
+
+        //Compute new mean
+        _mean_old = _mean;
+        _mean.noalias() = _elites * _weights;
+        const Eigen::VectorXd mean_step = (_mean - _mean_old) / _sigma;
+
+        //Update sigma evolutionary path, A^(-1) takes the place of C^(-1/2)
+        _p_sigma = (1. - _c_sig) * _p_sigma + std::sqrt(_c_sig * (2. - _c_sig) *
+                   _mu_eff) * (_invA * mean_step);
+
+        //Update C evolutionary path
+        const double h_sig = (_p_sigma.squaredNorm() / _N /
+                             (1. - std::pow((1. - _c_sig),
+                                            (2. * (double)_count_eval / _lambda))))
+                             < (2. + 4. / (_N + 1.));
+        _p_c = (1. - _c_c) * _p_c + h_sig * std::sqrt(_c_c * (2. - _c_c) * _mu_eff)
+               * mean_step;
+
+        //Decay the old covariance
+        const double alpha = 1. - _c_1 - _c_mu +
+                             _c_1 * (1. - h_sig) * _c_c * (2. - _c_c);
+        _A *= std::sqrt(alpha);
+        _invA /= std::sqrt(alpha);
+
+        //Rank-one update
+        rank_one_update(_c_1, _p_c);
+
+        //Rank-mu update as mu rank-one updates
+        _elites.colwise() -= _mean_old;
+        _elites /= _sigma;
+        for(unsigned i = 0; i < _mu; i++)
+            rank_one_update(_c_mu * _weights(i), _elites.col(i));
+
+        //Compute new sigma
+        _sigma *= std::exp(
+            std::min(0.6, (_c_sig / _d_sig) * (_p_sigma.norm() / _chiN - 1.)));
+
+        if(this->_trace)
+        {
+            std::cout << "Mean: " << std::endl << _mean << std::endl;
+            std::cout << "A: " << std::endl << _A << std::endl;
+            std::cout << "sigma: " << std::endl << _sigma << std::endl;
+        }
+
+        return sample_population(gp_map);
+
+    }
+
+private:
+
+    Population<double, T> initialise_population(
+        std::shared_ptr<GPMap<double, T>> gp_map) override
+    {
+        return sample_population(gp_map);
+    }
+
+    Population<double, T> sample_population(std::shared_ptr<GPMap<double, T>> gp_map)
+    {
+
+        //Draw an N x lambda matrix of standard normals
+        for(Eigen::Index i = 0; i < _samples.size(); i++)
+            _samples.data()[i] = _gauss_distr.next();
+
+        //Sample all individuals from the multivariate normal at once
+        _samples = _sigma * _A * _samples;
+        _samples.colwise() += _mean;
+
+        std::vector<Genotype<double>> genotypes;
+        genotypes.reserve(this->_pop_size);
+
+        for(unsigned i = 0; i < this->_pop_size; i++)
+            genotypes.push_back(Genotype<double>(
+                std::vector<double>(_samples.col(i).data(),
+                                    _samples.col(i).data() + this->_num_genes)));
+
+        return Population<double, T>(genotypes, gp_map, this->_thread_pool.get());
+    }
+
+    //Updates A and A^(-1) such that A * A^T becomes A * A^T + beta * v * v^T
+    void rank_one_update(const double beta, const Eigen::Ref<const Eigen::VectorXd>& v)
+    {
+        if(beta == 0.)
+            return;
+
+        _w.noalias() = _invA * v;
+        const double w_norm_sq = _w.squaredNorm();
+        if(w_norm_sq < 1e-20)
+            return;
+
+        const double root = std::sqrt(1. + beta * w_norm_sq);
+        const double a = (root - 1.) / w_norm_sq;
+        const double b = (1. - 1. / root) / w_norm_sq;
+
+        //A <- A + a * (A * w) * w^T, where A * w = v
+        _A.noalias() += a * v * _w.transpose();
+        //A^(-1) <- A^(-1) - b * w * (w^T * A^(-1))
+        _wT_invA.noalias() = _w.transpose() * _invA;
+        _invA.noalias() -= b * _w * _wT_invA;
+    }
+
+    Eigen::VectorXd calculate_weights() const
+    {
+        Eigen::VectorXd weights = Eigen::VectorXd::Zero(_mu);
+
+        //Weight creation procedure in pagmo
+        for(unsigned i = 0; i < _mu; i++)
+            weights(i) = std::log((double)_mu + 0.5) - std::log((double)i + 1);
+        weights /= weights.sum();
+
+        return weights;
+    }
+
+    CholeskyCMAES* clone_impl() const override
+    {
+        return new CholeskyCMAES(*this);
+    }
+
+    void reset() override
+    {
+        if(this->_seed.has_value())
+            _gauss_distr.set_seed(this->_seed.value());
+        else
+            _gauss_distr.randomly_seed();
+    }
+
+    Eigen::VectorXd _mean;
+    Eigen::VectorXd _mean_old;
+    double _sigma;
+    //Factor of the covariance matrix, C = A * A^T, and its inverse
+    Eigen::MatrixXd _A;
+    Eigen::MatrixXd _invA;
+
+    double _N;
+    double _lambda;
+
+    unsigned _mu;
+    Eigen::VectorXd _weights;
+
+    double _mu_eff;
+    double _c_mu;
+    double _c_c;
+    double _c_sig;
+    double _c_1;
+    double _d_sig;
+    double _chiN;
+
+    Eigen::VectorXd _p_c;
+    Eigen::VectorXd _p_sigma;
+
+    unsigned _count_eval;
+
+    //Working storage reused every generation
+    Eigen::MatrixXd _elites;
+    Eigen::MatrixXd _samples;
+    Eigen::VectorXd _w;
+    Eigen::RowVectorXd _wT_invA;
+
+    GaussianDistribution _gauss_distr;
+
+};
+
+static Factory<Optimiser<double, double>>::Registrar cholesky_cmaes_registrar(
+    "CholeskyCMAES",
+    [](const JSON& json)
+    {return std::make_shared<CholeskyCMAES<double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
@@ -39,6 +39,7 @@ public:
         _p_sigma(Eigen::VectorXd::Zero(this->_num_genes)),
         _count_eval(0),
         _eigen_eval(0),
+        _samples(Eigen::MatrixXd::Zero(this->_num_genes, this->_pop_size)),
         _gauss_distr(0, 1),
         _adapt_C(adapt_C)
     {
@@ -65,6 +66,7 @@ public:
         //Initialise constants
         _mu = pop_size / 2;
         _weights = calculate_weights();
+        _elites = Eigen::MatrixXd::Zero(this->_num_genes, _mu);
         _mu_eff = 1. / (_weights.transpose() * _weights);
 
         _N = static_cast<double>(this->_num_genes);
@@ -101,32 +103,28 @@ public:
 
         _count_eval += this->_pop_size;
 
-        //Sort population
+        //Sort population on the contiguous fitnesses
+        const std::vector<double>& fitnesses = this->_population.get_fitnesses();
         std::vector<std::size_t> sorted_pop_indices(this->_pop_size);
         std::iota(sorted_pop_indices.begin(), sorted_pop_indices.end(), 0);
-        std::sort(sorted_pop_indices.begin(), sorted_pop_indices.end(),
-                  [this](std::size_t i, std::size_t j)
-                  {
-                      auto fitnesses = this->_population.get_fitnesses();
-                      return fitnesses[i] > fitnesses[j];
-                  });
-
-        //Place elite genomes into Eigen vector
-        std::vector<Eigen::VectorXd> elites(_mu,
-                                            Eigen::VectorXd::Zero(this->_num_genes));
-        const auto& orgs = this->_population.get_organisms();
-        for(unsigned i = 0; i <_mu; i++)
-        {
-            const auto& genes = orgs[sorted_pop_indices[i]].get_genotype().genes();
-            for(std::size_t j = 0; j < this->_num_genes; j++)
-                elites[i](j) = genes[j];
-        }
+        std::partial_sort(sorted_pop_indices.begin(), sorted_pop_indices.begin() + _mu,
+                          sorted_pop_indices.end(),
+                          [&fitnesses](std::size_t i, std::size_t j)
+                          {
+                              return fitnesses[i] > fitnesses[j];
+                          });
+
+        //Place elite genomes into the columns of an N x mu matrix, straight from
+        //the rows of the gene matrix of the population
+        const std::vector<double>& genes = this->_population.get_genes();
+        for(unsigned i = 0; i < _mu; i++)
+            _elites.col(i) = Eigen::Map<const Eigen::VectorXd>(
+                genes.data() + sorted_pop_indices[i] * this->_num_genes,
+                this->_num_genes);
 
         //Compute new mean
         _mean_old = _mean;
-        _mean = elites[0] * _weights(0);
-        for(unsigned i = 1; i < _mu; i++)
-            _mean += elites[i] * _weights(i);
+        _mean.noalias() = _elites * _weights;
 
         //Update sigma evolutionary path
         _p_sigma = (1. - _c_sig) * _p_sigma + std::sqrt(_c_sig * (2. - _c_sig) *
@@ -143,14 +141,11 @@ public:
             _p_c = (1. - _c_c) * _p_c + h_sig * std::sqrt(_c_c * (2. - _c_c) * _mu_eff)
                     * (_mean - _mean_old) / _sigma;
 
-            //Compute new C
+            //Compute new C with the rank-mu update as one weighted product
+            _elites.colwise() -= _mean_old;
+            _elites /= _sigma;
             _C_old = _C;
-            _C = (elites[0] - _mean_old) * (elites[0] - _mean_old).transpose() *
-                 _weights(0);
-            for(unsigned i = 1; i < _mu; i++)
-                _C += (elites[i] - _mean_old) *
-                      (elites[i] - _mean_old).transpose() * _weights(i);
-            _C /= _sigma * _sigma;
+            _C.noalias() = _elites * _weights.asDiagonal() * _elites.transpose();
             _C = (1. - _c_1 - _c_mu) * _C_old + _c_mu * _C +
                 _c_1 * ((_p_c * _p_c.transpose()) + (1. - h_sig) * _c_c * (2. - _c_c) *
                         _C_old);
@@ -188,28 +183,26 @@ private:
     Population<double, T> sample_population(std::shared_ptr<GPMap<double, T>> gp_map)
     {
 
+        //Draw an N x lambda matrix of standard normals
+        for(Eigen::Index i = 0; i < _samples.size(); i++)
+            _samples.data()[i] = _gauss_distr.next();
+
+        //Sample all individuals from the multivariate normal at once
+        if(_adapt_C)
+            _samples = _sigma * (_B * _D.diagonal().asDiagonal()) * _samples;
+        else
+            _samples *= _sigma;
+        _samples.colwise() += _mean;
+
         std::vector<Genotype<double>> genotypes;
         genotypes.reserve(this->_pop_size);
 
         for(unsigned i = 0; i < this->_pop_size; i++)
-        {
-            Eigen::VectorXd norm_rands = Eigen::VectorXd::Zero(this->_num_genes);
-            for(unsigned j = 0; j < this->_num_genes; j++)
-                norm_rands(j) = _gauss_distr.next();
-
-            //Sample from multivariate normal
-            Eigen::VectorXd genes;
-            if(_adapt_C)
-                genes = _mean + (_sigma * _B * _D * norm_rands);
-            else
-                genes = _mean + (_sigma * norm_rands);
-
-            std::vector<double> genes_vec(genes.data(),
-                                          genes.data() + genes.rows() * genes.cols());
-            genotypes.push_back(Genotype<double>(genes_vec));
-        }
+            genotypes.push_back(Genotype<double>(
+                std::vector<double>(_samples.col(i).data(),
+                                    _samples.col(i).data() + this->_num_genes)));
 
-        return Population<double, T>(genotypes, gp_map);
+        return Population<double, T>(genotypes, gp_map, this->_thread_pool.get());
     }
 
     void perform_eigendecompostion()
@@ -311,6 +304,12 @@ private:
     unsigned _count_eval;
     unsigned _eigen_eval;
 
+    //Working matrices reused every generation
+    //Elite genomes as columns, N x mu
+    Eigen::MatrixXd _elites;
+    //Sampled genomes as columns, N x lambda
+    Eigen::MatrixXd _samples;
+
     Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> _es;
 
     GaussianDistribution _gauss_distr;
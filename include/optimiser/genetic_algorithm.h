@@ -27,11 +27,17 @@ public:
         _mutator(mutator),
         _init_distrs(init_distrs) {}
 
+    //Genetic operators hold random state so each copy gets its own, otherwise
+    //copies running on different threads would share it
     GeneticAlgorithm(const GeneticAlgorithm& genetic_algorithm) :
         Optimiser<G, T>(genetic_algorithm),
-        _selector(genetic_algorithm._selector),
-        _mutator(genetic_algorithm._mutator),
-        _init_distrs(genetic_algorithm._init_distrs) {}
+        _selector(genetic_algorithm._selector->clone()),
+        _mutator(genetic_algorithm._mutator->clone())
+    {
+        _init_distrs.reserve(genetic_algorithm._init_distrs.size());
+        for(const auto& distr : genetic_algorithm._init_distrs)
+            _init_distrs.push_back(distr->clone());
+    }
 
     GeneticAlgorithm(const JSON& json) :
         GeneticAlgorithm(
@@ -49,25 +55,52 @@ public:
         ) {}
 
 
+    //Two populations are ping-ponged between: the current population becomes
+    //the parents and the children are written over the organisms of the
+    //generation before, so once both exist no organisms are allocated
     Population<G, T> step(std::shared_ptr<GPMap<G, T>> gp_map) override
     {
 
-        std::vector<Organism<G, T>> new_orgs;
-        new_orgs.reserve(this->_pop_size);
+        std::swap(_parents, this->_population);
 
-        for(unsigned i = 0; i < this->_pop_size; i++)
+        //Selection
+        const auto& orgs = _parents.get_organisms();
+        const std::vector<std::size_t> parents = _selector->select_parents(
+            orgs, this->_pop_size);
+
+        //There is no previous generation to write over yet
+        if(this->_population.get_size() != this->_pop_size)
         {
-            //Selection
-            Organism<G, T> child_org = _selector->select(
-                this->_population.get_organisms());
+            std::vector<Organism<G, T>> new_orgs;
+            new_orgs.reserve(this->_pop_size);
+
+            for(const auto parent : parents)
+            {
+                //Children start unevaluated, only the genes are inherited
+                Organism<G, T> child_org(orgs[parent].get_genotype(), gp_map);
+
+                //Mutation
+                _mutator->mutate(child_org.get_genotype_mut().genes_mut());
+
+                new_orgs.push_back(std::move(child_org));
+            }
+
+            return Population<G, T>(new_orgs, this->_thread_pool.get());
+        }
+
+        for(std::size_t i = 0; i < parents.size(); i++)
+        {
+            Organism<G, T>& child_org = this->_population.get_mutable_organism(i);
+            child_org.inherit(orgs[parents[i]]);
 
             //Mutation
             _mutator->mutate(child_org.get_genotype_mut().genes_mut());
-
-            new_orgs.push_back(child_org);
+            this->_population.refresh_organism(i);
         }
 
-        return Population<G, T>(new_orgs);
+        this->_population.genesis(this->_thread_pool.get());
+
+        return std::move(this->_population);
 
     }
 
@@ -91,7 +124,7 @@ private:
             genotypes.push_back(Genotype<G>(genes));
         }
 
-        return Population<G, T>(genotypes, gp_map);
+        return Population<G, T>(genotypes, gp_map, this->_thread_pool.get());
 
     }
 
@@ -146,6 +179,8 @@ private:
     void reset() override
     {
 
+        _parents = Population<G, T>();
+
         _selector->reset(this->_seed);
         _mutator->reset(this->_seed);
 
@@ -162,6 +197,9 @@ private:
     std::shared_ptr<Mutator<G>> _mutator;
     //Add crossover at some point
 
+    //The parents of the current population, recycled into the next generation
+    Population<G, T> _parents;
+
     // A distribution for each gene
     std::vector<std::shared_ptr<Distribution<G>>> _init_distrs;
 
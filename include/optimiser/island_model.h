@@ -0,0 +1,360 @@
+#ifndef _ISLAND_MODEL_H_
+#define _ISLAND_MODEL_H_
+
+/*
+    An island model runs a number of sub-populations, each evolved by its own
+    copy of another optimiser (a GA or CMA-ES for example), on separate threads.
+    Every migration interval each island sends copies of its best organisms to
+    its neighbours in the topology, where they replace the worst organisms.
+    Migrants travel through lock-free single-producer single-consumer queues,
+    one for each directed edge of the topology.
+    In synchronous mode the islands wait for one another at each migration so
+    that every island receives its neighbours' migrants from the same
+    generation. Otherwise islands never wait and take whatever migrants have
+    arrived, so a slow island never holds up the others.
+    Generational data is collected from the first island and the final
+    generation is collected from the combined population of all islands.
+*/
+
+#include <optimiser/optimiser.h>
+#include <util/concurrency/spsc_queue.h>
+#include <util/statistics/counter_rng.h>
+
+#include <atomic>
+#include <barrier>
+#include <thread>
+
+namespace NeuroEvo {
+
+enum class IslandTopology
+{
+    Ring,
+    FullyConnected
+};
+
+template <typename G, typename T>
+class IslandModel : public Optimiser<G, T>
+{
+
+public:
+
+    IslandModel(std::shared_ptr<Optimiser<G, T>> island_optimiser,
+                const unsigned num_islands,
+                const unsigned migration_interval,
+                const unsigned num_migrants,
+                const IslandTopology topology = IslandTopology::Ring,
+                const bool synchronous = true,
+                const std::optional<unsigned>& seed = std::nullopt) :
+        Optimiser<G, T>(island_optimiser->_num_genes,
+                        island_optimiser->_max_gens,
+                        island_optimiser->_pop_size * num_islands,
+                        island_optimiser->_quit_when_domain_complete,
+                        island_optimiser->_num_trials,
+                        seed),
+        _island_optimiser(island_optimiser),
+        _num_islands(num_islands),
+        _migration_interval(migration_interval),
+        _num_migrants(num_migrants),
+        _topology(topology),
+        _synchronous(synchronous)
+    {
+        if(_num_islands == 0)
+            throw std::invalid_argument("IslandModel needs at least one island");
+
+        if(_migration_interval == 0)
+            throw std::invalid_argument("IslandModel migration interval must be "
+                                        "at least 1");
+
+        if(_num_migrants > island_optimiser->_pop_size)
+            throw std::invalid_argument("IslandModel cannot send more migrants than "
+                                        "there are organisms on an island");
+    }
+
+    IslandModel(const JSON& json) :
+        IslandModel(Factory<Optimiser<G, T>>::create(json.at({"Optimiser"})),
+                    json.at({"num_islands"}),
+                    json.at({"migration_interval"}),
+                    json.at({"num_migrants"}),
+                    parse_topology(json.value({"topology"}, std::string("Ring"))),
+                    json.value({"synchronous"}, true)) {}
+
+    bool optimise(std::vector<std::unique_ptr<Domain<G, T>>>& domains,
+                  std::shared_ptr<GPMap<G, T>> gp_map,
+                  DataCollector<G, T>& data_collector) override
+    {
+
+        //Each island gets its own optimiser, domains and GPMap so that islands
+        //share no state other than the thread pool
+        std::vector<Island> islands(_num_islands);
+        for(unsigned i = 0; i < _num_islands; i++)
+        {
+            islands[i].optimiser = _island_optimiser->clone();
+            islands[i].optimiser->set_thread_pool(this->_thread_pool);
+            seed_island(*islands[i].optimiser, i);
+
+            for(const auto& domain : domains)
+                islands[i].domains.push_back(domain->clone());
+
+            islands[i].gp_map = gp_map->clone();
+        }
+
+        //One queue for each directed edge of the topology, indexed [from][to]
+        MigrationQueues queues(_num_islands);
+        for(unsigned from = 0; from < _num_islands; from++)
+        {
+            queues[from].resize(_num_islands);
+            for(const unsigned to : neighbours(from))
+                queues[from][to] =
+                    std::make_unique<SPSCQueue<Organism<G, T>>>(2 * _num_migrants);
+        }
+
+        const double average_domain_completion_fitness =
+            std::accumulate(
+                domains.begin(),
+                domains.end(),
+                0.0,
+                [](const double sum_so_far,
+                   const std::unique_ptr<Domain<G, T>>& domain)
+                {return sum_so_far + domain->get_completion_fitness();}
+            ) / domains.size();
+
+        std::barrier<> migration_barrier(_num_islands);
+        std::atomic<bool> stop(false);
+
+        std::vector<std::thread> threads;
+        threads.reserve(_num_islands);
+        for(unsigned i = 0; i < _num_islands; i++)
+            threads.emplace_back(&IslandModel::run_island, this, i,
+                                 std::ref(islands[i]), std::ref(queues),
+                                 std::ref(migration_barrier), std::ref(stop),
+                                 average_domain_completion_fitness,
+                                 std::ref(data_collector));
+        for(auto& thread : threads)
+            thread.join();
+
+        //Combine the islands into a single population
+        std::vector<Organism<G, T>> organisms;
+        organisms.reserve(this->_pop_size);
+        unsigned finished_gen = 0;
+        for(const auto& island : islands)
+        {
+            const auto& island_orgs = island.optimiser->_population.get_organisms();
+            organisms.insert(organisms.end(), island_orgs.begin(), island_orgs.end());
+            finished_gen = std::max(finished_gen, island.finished_gen);
+        }
+        this->_population = Population<G, T>(organisms);
+        this->_finished_gen = finished_gen;
+
+        data_collector.collect_generational_data(this->_population, finished_gen, true,
+                                                 domains);
+
+        //A domain is complete if it was completed on any island
+        unsigned num_domains_completed = 0;
+        for(std::size_t j = 0; j < domains.size(); j++)
+        {
+            bool complete = false;
+            for(const auto& island : islands)
+                complete = complete || island.domains[j]->complete();
+            domains[j]->set_complete(complete);
+
+            if(complete)
+                num_domains_completed++;
+        }
+
+        return num_domains_completed == domains.size();
+
+    }
+
+    //Islands are reset when they are created at the start of each optimisation
+    void reset() override {}
+
+private:
+
+    struct Island
+    {
+        std::unique_ptr<Optimiser<G, T>> optimiser;
+        std::vector<std::unique_ptr<Domain<G, T>>> domains;
+        std::shared_ptr<GPMap<G, T>> gp_map;
+        unsigned finished_gen = 0;
+    };
+
+    typedef std::vector<std::vector<std::unique_ptr<SPSCQueue<Organism<G, T>>>>>
+        MigrationQueues;
+
+    void run_island(const unsigned island_num,
+                    Island& island,
+                    MigrationQueues& queues,
+                    std::barrier<>& migration_barrier,
+                    std::atomic<bool>& stop,
+                    const double average_domain_completion_fitness,
+                    DataCollector<G, T>& data_collector)
+    {
+
+        Optimiser<G, T>& optimiser = *island.optimiser;
+        optimiser._population = optimiser.initialise_population(island.gp_map);
+
+        unsigned gen = 1;
+
+        while(true)
+        {
+            optimiser.evaluate_population(optimiser._population, island.domains,
+                                          optimiser._num_trials,
+                                          average_domain_completion_fitness);
+
+            //Once one island finishes they all do
+            const bool finished = optimiser.optimisation_finished(gen, island.domains) ||
+                                  stop.load(std::memory_order_relaxed);
+            if(finished)
+            {
+                stop.store(true, std::memory_order_relaxed);
+                break;
+            }
+
+            if(island_num == 0)
+                data_collector.collect_generational_data(optimiser._population, gen,
+                                                         false, island.domains);
+
+            if(gen % _migration_interval == 0)
+                migrate(island_num, optimiser._population, queues, migration_barrier);
+
+            optimiser._population = optimiser.step(island.gp_map);
+            gen++;
+        }
+
+        island.finished_gen = gen;
+
+        //Stop the other islands waiting on this one
+        if(_synchronous)
+            migration_barrier.arrive_and_drop();
+
+    }
+
+    void migrate(const unsigned island_num,
+                 Population<G, T>& population,
+                 MigrationQueues& queues,
+                 std::barrier<>& migration_barrier)
+    {
+
+        const std::vector<double>& fitnesses = population.get_fitnesses();
+        std::vector<std::size_t> sorted_indices(fitnesses.size());
+        std::iota(sorted_indices.begin(), sorted_indices.end(), 0);
+        std::sort(sorted_indices.begin(), sorted_indices.end(),
+                  [&fitnesses](std::size_t i, std::size_t j)
+                  {
+                      return fitnesses[i] > fitnesses[j];
+                  });
+
+        //Send copies of the best organisms to each neighbour, migrants are dropped
+        //if a neighbour has not yet taken the last ones
+        const auto& orgs = population.get_organisms();
+        for(const unsigned to : neighbours(island_num))
+            for(unsigned i = 0; i < _num_migrants; i++)
+                queues[island_num][to]->try_push(orgs[sorted_indices[i]]);
+
+        if(_synchronous)
+            migration_barrier.arrive_and_wait();
+
+        //Immigrants replace the worst organisms but never the organisms that were
+        //just sent away
+        std::size_t num_replaceable = population.get_size() - _num_migrants;
+        for(unsigned from = 0; from < _num_islands; from++)
+        {
+            if(!queues[from][island_num])
+                continue;
+
+            while(auto immigrant = queues[from][island_num]->try_pop())
+                if(num_replaceable > 0)
+                {
+                    population.set_organism(
+                        sorted_indices[_num_migrants + num_replaceable - 1],
+                        std::move(immigrant.value()));
+                    num_replaceable--;
+                }
+        }
+
+    }
+
+    std::vector<unsigned> neighbours(const unsigned island_num) const
+    {
+        std::vector<unsigned> island_neighbours;
+
+        if(_num_islands == 1)
+            return island_neighbours;
+
+        switch(_topology)
+        {
+            case IslandTopology::Ring:
+                island_neighbours.push_back((island_num + 1) % _num_islands);
+                break;
+            case IslandTopology::FullyConnected:
+                for(unsigned i = 0; i < _num_islands; i++)
+                    if(i != island_num)
+                        island_neighbours.push_back(i);
+                break;
+        }
+
+        return island_neighbours;
+    }
+
+    //Each island gets a different seed derived from the island model's seed or,
+    //if it has none, from the seed of the island optimiser
+    void seed_island(Optimiser<G, T>& optimiser, const unsigned island_num) const
+    {
+        const std::optional<unsigned> seed = this->_seed.has_value() ?
+                                             this->_seed :
+                                             _island_optimiser->_seed;
+
+        if(seed.has_value())
+            optimiser.seed_optimiser(static_cast<unsigned>(
+                CounterRNG::derive_seed(seed.value(), {island_num})));
+
+        optimiser.reset();
+    }
+
+    static IslandTopology parse_topology(const std::string& topology)
+    {
+        if(topology == "Ring")
+            return IslandTopology::Ring;
+        else if(topology == "FullyConnected")
+            return IslandTopology::FullyConnected;
+        else
+            throw std::invalid_argument(topology + " is not an island topology, use "
+                                        "Ring or FullyConnected");
+    }
+
+    //Each island runs the whole generation loop itself in optimise
+    Population<G, T> step(std::shared_ptr<GPMap<G, T>>) override
+    {
+        throw std::logic_error("IslandModel populations are stepped by its islands");
+    }
+
+    Population<G, T> initialise_population(
+        std::shared_ptr<GPMap<G, T>>) override
+    {
+        throw std::logic_error("IslandModel populations are initialised by its islands");
+    }
+
+    IslandModel* clone_impl() const override
+    {
+        return new IslandModel(*this);
+    }
+
+    //Copied to create each island
+    std::shared_ptr<Optimiser<G, T>> _island_optimiser;
+
+    const unsigned _num_islands;
+    const unsigned _migration_interval;
+    const unsigned _num_migrants;
+    const IslandTopology _topology;
+    const bool _synchronous;
+
+};
+
+static Factory<Optimiser<double, double>>::Registrar island_model_registrar(
+    "IslandModel",
+    [](const JSON& json)
+    {return std::make_shared<IslandModel<double, double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
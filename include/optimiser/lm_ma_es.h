@@ -0,0 +1,268 @@
+#ifndef _LM_MA_ES_H_
+#define _LM_MA_ES_H_
+
+/*
+    Limited-Memory Matrix Adaptation Evolution Strategy
+    (Loshchilov, Glasmachers & Beyer 2017).
+    This is a limited-memory CMA-ES variant. Instead of storing an N x N covariance
+    matrix, the search distribution is described by m direction vectors that are
+    applied to each standard normal sample as a sequence of rank-one
+    transformations. Memory is O(mN) and the cost of a generation is
+    O(m N lambda), no matrix decomposition is ever performed.
+*/
+
+#include <optimiser/optimiser.h>
+#include <util/statistics/distributions/gaussian_distribution.h>
+
+#include <Eigen/Dense>
+
+namespace NeuroEvo {
+
+template <typename T>
+class LMMAES : public Optimiser<double, T>
+{
+
+public:
+
+    //If memory size is not given, the default of 4 + 3ln(N) is used
+    LMMAES(std::vector<double> init_mean,
+           double init_sigma,
+           const unsigned num_genes,
+           const unsigned max_gens,
+           const unsigned pop_size,
+           const bool quit_when_domain_complete = true,
+           const unsigned num_trials = 1,
+           const std::optional<unsigned>& memory_size = std::nullopt,
+           const std::optional<unsigned>& seed = std::nullopt) :
+        Optimiser<double, T>(num_genes, max_gens, pop_size, quit_when_domain_complete,
+                             num_trials, seed),
+        _mean(Eigen::VectorXd::Zero(this->_num_genes)),
+        _sigma(init_sigma),
+        _p_sigma(Eigen::VectorXd::Zero(this->_num_genes)),
+        _num_directions_used(0),
+        _z(Eigen::MatrixXd::Zero(this->_num_genes, this->_pop_size)),
+        _d(Eigen::MatrixXd::Zero(this->_num_genes, this->_pop_size)),
+        _gauss_distr(0, 1)
+    {
+
+        //If only one element is given in initial mean vector, assume that this value
+        //is to be repeated for all genes
+        if(init_mean.size() == 1)
+            init_mean = std::vector<double>(num_genes, init_mean.at(0));
+
+        if(init_mean.size() != this->_num_genes)
+            throw std::length_error("Initial mean vector to LMMAES is not the same "
+                                    "size as number of genes");
+
+        _mean = Eigen::Map<const Eigen::VectorXd>(init_mean.data(), init_mean.size());
+
+        _N = static_cast<double>(this->_num_genes);
+        _lambda = static_cast<double>(this->_pop_size);
+
+        _memory_size = memory_size.has_value() ? memory_size.value() :
+                       4 + static_cast<unsigned>(std::floor(3. * std::log(_N)));
+        _M = Eigen::MatrixXd::Zero(this->_num_genes, _memory_size);
+
+        //Initialise constants
+        _mu = pop_size / 2;
+        _weights = calculate_weights();
+        _mu_eff = 1. / (_weights.transpose() * _weights);
+
+        //Capped for small problems where lambda is large relative to N
+        _c_sig = std::min(1., 2. * _lambda / _N);
+
+        //Learning rates of each direction vector decay geometrically so that the
+        //directions span different time scales
+        _c_d = Eigen::VectorXd::Zero(_memory_size);
+        _c_c = Eigen::VectorXd::Zero(_memory_size);
+        for(unsigned i = 0; i < _memory_size; i++)
+        {
+            _c_d(i) = 1. / (std::pow(1.5, i) * _N);
+            _c_c(i) = std::min(1., _lambda / (std::pow(4., i) * _N));
+        }
+
+    }
+
+    LMMAES(const JSON& json) :
+        LMMAES(json.at({"init_mean"}),
+               json.at({"init_sigma"}),
+               json.at({"num_genes"}),
+               json.at({"num_gens"}),
+               json.at({"pop_size"}),
+               json.at({"quit_domain_when_complete"}),
+               json.at({"num_trials"}),
+               json.optional_value<unsigned>({"memory_size"})) {}
+
+    Population<double, T> step(std::shared_ptr<GPMap<double, T>> gp_map) override
+    {
+
+        //Sort population on the contiguous fitnesses
+        const std::vector<double>& fitnesses = this->_population.get_fitnesses();
+        std::vector<std::size_t> sorted_pop_indices(this->_pop_size);
+        std::iota(sorted_pop_indices.begin(), sorted_pop_indices.end(), 0);
+        std::partial_sort(sorted_pop_indices.begin(), sorted_pop_indices.begin() + _mu,
+                          sorted_pop_indices.end(),
+                          [&fitnesses](std::size_t i, std::size_t j)
+                          {
+                              return fitnesses[i] > fitnesses[j];
+                          });
+
+        //Weighted recombination of the elite samples and their transformed
+        //directions
+        Eigen::VectorXd z_w = Eigen::VectorXd::Zero(this->_num_genes);
+        Eigen::VectorXd d_w = Eigen::VectorXd::Zero(this->_num_genes);
+        for(unsigned i = 0; i < _mu; i++)
+        {
+            recover_sample(sorted_pop_indices[i]);
+            z_w += _weights(i) * _z.col(sorted_pop_indices[i]);
+            d_w += _weights(i) * _d.col(sorted_pop_indices[i]);
+        }
+
+        //Compute new mean
+        _mean += _sigma * d_w;
+
+        //Update sigma evolutionary path
+        _p_sigma = (1. - _c_sig) * _p_sigma +
+                   std::sqrt(_mu_eff * _c_sig * (2. - _c_sig)) * z_w;
+
+        //Update direction vectors
+        for(unsigned i = 0; i < _memory_size; i++)
+            _M.col(i) = (1. - _c_c(i)) * _M.col(i) +
+                        std::sqrt(_mu_eff * _c_c(i) * (2. - _c_c(i))) * z_w;
+        _num_directions_used = std::min(_num_directions_used + 1, _memory_size);
+
+        //Compute new sigma
+        _sigma *= std::exp(
+            std::min(0.6, (_c_sig / 2.) * (_p_sigma.squaredNorm() / _N - 1.)));
+
+        if(this->_trace)
+        {
+            std::cout << "Mean: " << std::endl << _mean << std::endl;
+            std::cout << "sigma: " << std::endl << _sigma << std::endl;
+        }
+
+        return sample_population(gp_map);
+
+    }
+
+private:
+
+    Population<double, T> initialise_population(
+        std::shared_ptr<GPMap<double, T>> gp_map) override
+    {
+        return sample_population(gp_map);
+    }
+
+    Population<double, T> sample_population(std::shared_ptr<GPMap<double, T>> gp_map)
+    {
+
+        //Draw an N x lambda matrix of standard normals
+        for(Eigen::Index i = 0; i < _z.size(); i++)
+            _z.data()[i] = _gauss_distr.next();
+
+        //Apply each rank-one transformation to all samples at once
+        _d = _z;
+        for(unsigned i = 0; i < _num_directions_used; i++)
+            _d = (1. - _c_d(i)) * _d +
+                 _c_d(i) * _M.col(i) * (_M.col(i).transpose() * _d);
+
+        std::vector<Genotype<double>> genotypes;
+        genotypes.reserve(this->_pop_size);
+
+        std::vector<double> genes(this->_num_genes);
+        for(unsigned i = 0; i < this->_pop_size; i++)
+        {
+            Eigen::Map<Eigen::VectorXd>(genes.data(), this->_num_genes) =
+                _mean + _sigma * _d.col(i);
+            genotypes.push_back(Genotype<double>(genes));
+        }
+
+        return Population<double, T>(genotypes, gp_map, this->_thread_pool.get());
+    }
+
+    //Organisms written over from outside the optimiser, such as the migrants of
+    //an island model, were not drawn from the sample of their index, so their
+    //sample and direction are worked back from their genes. Each rank-one
+    //transformation is undone with the Sherman-Morrison formula.
+    void recover_sample(const std::size_t org)
+    {
+        const Eigen::Map<const Eigen::VectorXd> x(
+            this->_population.get_genes().data() + org * this->_num_genes,
+            this->_num_genes);
+
+        if(x.cwiseEqual(_mean + _sigma * _d.col(org)).all())
+            return;
+
+        _d.col(org) = (x - _mean) / _sigma;
+
+        Eigen::VectorXd z = _d.col(org);
+        for(unsigned i = _num_directions_used; i-- > 0;)
+            z = (z - _c_d(i) / (1. - _c_d(i) + _c_d(i) * _M.col(i).squaredNorm()) *
+                     _M.col(i) * _M.col(i).dot(z)) / (1. - _c_d(i));
+        _z.col(org) = z;
+    }
+
+    Eigen::VectorXd calculate_weights() const
+    {
+        Eigen::VectorXd weights = Eigen::VectorXd::Zero(_mu);
+
+        //Weight creation procedure in pagmo
+        for(unsigned i = 0; i < _mu; i++)
+            weights(i) = std::log((double)_mu + 0.5) - std::log((double)i + 1);
+        weights /= weights.sum();
+
+        return weights;
+    }
+
+    LMMAES* clone_impl() const override
+    {
+        return new LMMAES(*this);
+    }
+
+    void reset() override
+    {
+        if(this->_seed.has_value())
+            _gauss_distr.set_seed(this->_seed.value());
+        else
+            _gauss_distr.randomly_seed();
+    }
+
+    Eigen::VectorXd _mean;
+    double _sigma;
+
+    double _N;
+    double _lambda;
+
+    unsigned _mu;
+    Eigen::VectorXd _weights;
+
+    double _mu_eff;
+    double _c_sig;
+    //Per direction learning rates
+    Eigen::VectorXd _c_d;
+    Eigen::VectorXd _c_c;
+
+    Eigen::VectorXd _p_sigma;
+
+    //Direction vectors as columns, N x m
+    unsigned _memory_size;
+    Eigen::MatrixXd _M;
+    //The number of direction vectors that have been updated at least once
+    unsigned _num_directions_used;
+
+    //Samples and their transformed directions from the last generation,
+    //N x lambda
+    Eigen::MatrixXd _z;
+    Eigen::MatrixXd _d;
+
+    GaussianDistribution _gauss_distr;
+
+};
+
+static Factory<Optimiser<double, double>>::Registrar lm_ma_es_registrar("LMMAES",
+    [](const JSON& json)
+    {return std::make_shared<LMMAES<double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
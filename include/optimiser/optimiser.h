@@ -8,6 +8,7 @@
 #include <population.h>
 #include <domains/domain.h>
 #include <data/data_collection.h>
+#include <util/concurrency/clone_pool.h>
 
 namespace NeuroEvo {
 
@@ -38,15 +39,16 @@ public:
         _num_trials(optimiser._num_trials),
         _seed(optimiser._seed),
         _trace(optimiser._trace),
+        _thread_pool(optimiser._thread_pool),
         _quit_when_domain_complete(optimiser._quit_when_domain_complete) {}
 
     virtual ~Optimiser() = default;
 
     //Optimise according to optimiser algorithm
     //Returns bool to indicate whether all domains were solved or not
-    bool optimise(std::vector<std::unique_ptr<Domain<G, T>>>& domains,
-                  std::shared_ptr<GPMap<G, T>> gp_map,
-                  DataCollector<G, T>& data_collector) {
+    virtual bool optimise(std::vector<std::unique_ptr<Domain<G, T>>>& domains,
+                          std::shared_ptr<GPMap<G, T>> gp_map,
+                          DataCollector<G, T>& data_collector) {
 
         _population = initialise_population(gp_map);
         
@@ -130,6 +132,13 @@ public:
         _trace = trace;
     }
 
+    //Phenotypes are built and organisms are evaluated on the domains on the
+    //threads of the pool, the pool can be shared with other optimisers
+    void set_thread_pool(std::shared_ptr<ThreadPool> thread_pool)
+    {
+        _thread_pool = thread_pool;
+    }
+
     auto clone() const
     {
         return std::unique_ptr<Optimiser>(clone_impl());
@@ -140,6 +149,9 @@ public:
 
 protected:
 
+    //Island models drive a generation at a time of other optimisers
+    template <typename, typename> friend class IslandModel;
+
     //Applies evolutionary operators and creates new population
     //This is different for each optimiser
     virtual Population<G, T> step(std::shared_ptr<GPMap<G, T>> gp_map) = 0;
@@ -164,6 +176,9 @@ protected:
 
     bool _trace;
 
+    //Null if phenotypes are built and evaluated on the optimiser's thread
+    std::shared_ptr<ThreadPool> _thread_pool;
+
 private:
 
     void evaluate_population(
@@ -173,14 +188,29 @@ private:
         const double average_domain_completion_fitness
     )
     {
+        //Every organism is run on the same trials of each domain
+        std::vector<std::vector<unsigned>> trial_seeds;
+        trial_seeds.reserve(domains.size());
+        for(auto& domain : domains)
+            trial_seeds.push_back(domain->next_trial_seeds(num_trials));
+
+        //Each domain is handed whole ranges of the population so it can run the
+        //organisms together
+        const std::vector<std::vector<double>> fitnesses = _thread_pool ?
+            evaluate_population_parallel(population, domains, trial_seeds) :
+            evaluate_population_serial(population, domains, trial_seeds);
+
         for(std::size_t i = 0; i < population.get_size(); i++)
         {
             double total_fitness = 0.0;
 
             for(std::size_t j = 0; j < domains.size(); j++)
-                total_fitness += domains[j]->evaluate(
-                    population.get_mutable_organism(i)
-                );    
+            {
+                double total_trial_fitness = 0.0;
+                for(std::size_t k = 0; k < num_trials; k++)
+                    total_trial_fitness += fitnesses[j][i * num_trials + k];
+                total_fitness += total_trial_fitness / num_trials;
+            }
 
             const double average_fitness = total_fitness / domains.size();
 
@@ -196,6 +226,121 @@ private:
             domain->set_complete(domain->check_for_completion(population));
     }
 
+    //The fitnesses of every domain indexed by org * num_trials + trial
+    std::vector<std::vector<double>> evaluate_population_serial(
+        Population<G, T>& population,
+        const std::vector<std::unique_ptr<Domain<G, T>>>& domains,
+        const std::vector<std::vector<unsigned>>& trial_seeds
+    )
+    {
+        std::vector<std::vector<double>> fitnesses;
+        fitnesses.reserve(domains.size());
+        for(std::size_t j = 0; j < domains.size(); j++)
+            fitnesses.push_back(
+                domains[j]->evaluate_trials(population, trial_seeds[j])
+            );
+        return fitnesses;
+    }
+
+    //Each task evaluates a chunk of the organisms on a chunk of the trials of
+    //one domain, through evaluate_trials so domains that run many organisms
+    //together still do. Organisms are split first and trials only once there
+    //are too few organisms to keep the threads busy. Evaluating rebuilds and
+    //runs the phenotypes, so the tasks of one domain and chunk of trials run
+    //disjoint organisms in the same population and every other pair of domain
+    //and chunk of trials is given its own copy of the population. Tasks
+    //running at the same time each borrow their own copy of a domain. The
+    //domains given are left untouched.
+    std::vector<std::vector<double>> evaluate_population_parallel(
+        Population<G, T>& population,
+        const std::vector<std::unique_ptr<Domain<G, T>>>& domains,
+        const std::vector<std::vector<unsigned>>& trial_seeds
+    )
+    {
+        const std::size_t num_orgs = population.get_size();
+        const std::size_t num_domains = domains.size();
+        std::vector<std::vector<double>> fitnesses(num_domains);
+        for(std::size_t j = 0; j < num_domains; j++)
+            fitnesses[j].resize(num_orgs * trial_seeds[j].size());
+        if(num_orgs == 0)
+            return fitnesses;
+
+        //Copies are taken afresh each generation so they match the domains
+        std::vector<std::unique_ptr<ClonePool<Domain<G, T>>>> domain_copies;
+        domain_copies.reserve(num_domains);
+        for(const auto& domain : domains)
+            domain_copies.push_back(std::make_unique<ClonePool<Domain<G, T>>>(
+                [&domain]() {return domain->clone();}));
+
+        //A few tasks per thread keep the threads busy when some organisms take
+        //longer than others
+        const std::size_t tasks_per_domain = std::max<std::size_t>(
+            1, (4 * _thread_pool->get_num_threads() + num_domains - 1) / num_domains);
+        const std::size_t num_org_chunks =
+            std::min<std::size_t>(num_orgs, tasks_per_domain);
+
+        //The tasks of domain j start at task_offsets[j] and run through its
+        //chunks of trials and then the chunks of organisms within them
+        std::vector<std::size_t> num_trial_chunks(num_domains);
+        std::vector<std::size_t> task_offsets(num_domains + 1, 0);
+        //One population for every pair of domain and chunk of trials
+        std::vector<Population<G, T>*> populations;
+        std::vector<std::unique_ptr<Population<G, T>>> population_copies;
+        for(std::size_t j = 0; j < num_domains; j++)
+        {
+            num_trial_chunks[j] = std::min<std::size_t>(
+                trial_seeds[j].size(),
+                (tasks_per_domain + num_org_chunks - 1) / num_org_chunks);
+            task_offsets[j + 1] = task_offsets[j] + num_trial_chunks[j] * num_org_chunks;
+
+            for(std::size_t k = 0; k < num_trial_chunks[j]; k++)
+                if(populations.empty())
+                    populations.push_back(&population);
+                else
+                {
+                    population_copies.push_back(std::make_unique<Population<G, T>>(
+                        population.get_organisms(), _thread_pool.get()));
+                    populations.push_back(population_copies.back().get());
+                }
+        }
+
+        _thread_pool->parallel_for(
+            task_offsets.back(),
+            [&populations, &domain_copies, &trial_seeds, &fitnesses,
+             &num_trial_chunks, &task_offsets, num_orgs,
+             num_org_chunks](const std::size_t task)
+            {
+                std::size_t j = 0;
+                std::size_t first_population = 0;
+                while(task >= task_offsets[j + 1])
+                    first_population += num_trial_chunks[j++];
+
+                const std::size_t num_trials = trial_seeds[j].size();
+                const std::size_t trial_chunk = (task - task_offsets[j]) / num_org_chunks;
+                const std::size_t org_chunk = (task - task_offsets[j]) % num_org_chunks;
+                const std::size_t first_org = org_chunk * num_orgs / num_org_chunks;
+                const std::size_t last_org = (org_chunk + 1) * num_orgs / num_org_chunks;
+                const std::size_t first_trial =
+                    trial_chunk * num_trials / num_trial_chunks[j];
+                const std::size_t last_trial =
+                    (trial_chunk + 1) * num_trials / num_trial_chunks[j];
+
+                const std::vector<double> chunk_fitnesses =
+                    domain_copies[j]->borrow()->evaluate_trials(
+                        *populations[first_population + trial_chunk], trial_seeds[j],
+                        first_org, last_org, first_trial, last_trial);
+
+                const std::size_t chunk_trials = last_trial - first_trial;
+                for(std::size_t i = first_org; i < last_org; i++)
+                    std::copy_n(chunk_fitnesses.begin() + (i - first_org) * chunk_trials,
+                                chunk_trials,
+                                fitnesses[j].begin() + i * num_trials + first_trial);
+            }
+        );
+
+        return fitnesses;
+    }
+
     bool optimisation_finished(
         const unsigned curr_gen,
         const std::vector<std::unique_ptr<Domain<G, T>>>& domains
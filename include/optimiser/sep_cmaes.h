@@ -0,0 +1,254 @@
+#ifndef _SEP_CMAES_H_
+#define _SEP_CMAES_H_
+
+/*
+    Separable CMA-ES (Ros & Hansen 2008).
+    The covariance matrix is restricted to a diagonal so memory and time per
+    generation are O(N) rather than O(N^2) and no eigendecomposition is needed.
+    The learning rates of the covariance are increased by (N + 2) / 3 to make up
+    for the smaller number of parameters being learnt.
+*/
+
+#include <optimiser/optimiser.h>
+#include <util/statistics/distributions/gaussian_distribution.h>
+
+#include <Eigen/Dense>
+
+namespace NeuroEvo {
+
+template <typename T>
+class SepCMAES : public Optimiser<double, T>
+{
+
+public:
+
+    SepCMAES(std::vector<double> init_mean,
+             double init_sigma,
+             const unsigned num_genes,
+             const unsigned max_gens,
+             const unsigned pop_size,
+             const bool quit_when_domain_complete = true,
+             const unsigned num_trials = 1,
+             const std::optional<unsigned>& seed = std::nullopt) :
+        Optimiser<double, T>(num_genes, max_gens, pop_size, quit_when_domain_complete,
+                             num_trials, seed),
+        _mean(Eigen::VectorXd::Zero(this->_num_genes)),
+        _mean_old(Eigen::VectorXd::Zero(this->_num_genes)),
+        _sigma(init_sigma),
+        _C_diag(Eigen::ArrayXd::Ones(this->_num_genes)),
+        _p_c(Eigen::VectorXd::Zero(this->_num_genes)),
+        _p_sigma(Eigen::VectorXd::Zero(this->_num_genes)),
+        _count_eval(0),
+        _samples(Eigen::MatrixXd::Zero(this->_num_genes, this->_pop_size)),
+        _gauss_distr(0, 1)
+    {
+
+        //If only one element is given in initial mean vector, assume that this value
+        //is to be repeated for all genes
+        if(init_mean.size() == 1)
+            init_mean = std::vector<double>(num_genes, init_mean.at(0));
+
+        if(init_mean.size() != this->_num_genes)
+            throw std::length_error("Initial mean vector to SepCMAES is not the same "
+                                    "size as number of genes");
+
+        _mean = Eigen::Map<const Eigen::VectorXd>(init_mean.data(), init_mean.size());
+
+        //Initialise constants
+        _mu = pop_size / 2;
+        _weights = calculate_weights();
+        _elites = Eigen::MatrixXd::Zero(this->_num_genes, _mu);
+        _mu_eff = 1. / (_weights.transpose() * _weights);
+
+        _N = static_cast<double>(this->_num_genes);
+        _lambda = static_cast<double>(this->_pop_size);
+
+        _c_c = (4. + _mu_eff / _N) / (_N + 4. + 2. * _mu_eff / _N);
+        _c_sig = (_mu_eff + 2.) / (_N + _mu_eff + 5.);
+        const double alpha_cov = 2.;
+        //Diagonal learning rates are sped up by (N + 2) / 3
+        const double sep_factor = (_N + 2.) / 3.;
+        _c_1 = std::min(1., sep_factor * alpha_cov /
+                                ((_N + 1.3) * (_N + 1.3) + _mu_eff));
+        _c_mu = std::min(1 - _c_1,
+                         sep_factor * alpha_cov * (_mu_eff -2. + 1. / _mu_eff) /
+                                     ((_N + 2.) * (_N + 2.) + alpha_cov *
+                                      _mu_eff / 2.));
+
+        _d_sig = 1. + 2. * std::max(0., std::sqrt((_mu_eff - 1.) / (_N + 1.)) - 1.) +
+                 _c_sig;
+        //Expectation of ||N(0,I)|| == norm(randn(N,1))
+        _chiN = std::sqrt(_N) * (1. - 1. / (4. * _N) + 1. / (21. * _N * _N));
+
+    }
+
+    SepCMAES(const JSON& json) :
+        SepCMAES(json.at({"init_mean"}),
+                 json.at({"init_sigma"}),
+                 json.at({"num_genes"}),
+                 json.at({"num_gens"}),
+                 json.at({"pop_size"}),
+                 json.at({"quit_domain_when_complete"}),
+                 json.at({"num_trials"})) {}
+
+    Population<double, T> step(std::shared_ptr<GPMap<double, T>> gp_map) override
+    {
+
+        _count_eval += this->_pop_size;
+
+        //Sort population on the contiguous fitnesses
+        const std::vector<double>& fitnesses = this->_population.get_fitnesses();
+        std::vector<std::size_t> sorted_pop_indices(this->_pop_size);
+        std::iota(sorted_pop_indices.begin(), sorted_pop_indices.end(), 0);
+        std::partial_sort(sorted_pop_indices.begin(), sorted_pop_indices.begin() + _mu,
+                          sorted_pop_indices.end(),
+                          [&fitnesses](std::size_t i, std::size_t j)
+                          {
+                              return fitnesses[i] > fitnesses[j];
+                          });
+
+        //Place elite genomes into the columns of an N x mu matrix, straight from
+        //the rows of the gene matrix of the population
+        const std::vector<double>& genes = this->_population.get_genes();
+        for(unsigned i = 0; i < _mu; i++)
+            _elites.col(i) = Eigen::Map<const Eigen::VectorXd>(
+                genes.data() + sorted_pop_indices[i] * this->_num_genes,
+                this->_num_genes);
+
+        //Compute new mean
+        _mean_old = _mean;
+        _mean.noalias() = _elites * _weights;
+        const Eigen::VectorXd mean_step = (_mean - _mean_old) / _sigma;
+
+        //Update sigma evolutionary path, C^(-1/2) is just a diagonal scaling
+        _p_sigma = (1. - _c_sig) * _p_sigma + std::sqrt(_c_sig * (2. - _c_sig) *
+                   _mu_eff) * (mean_step.array() / _C_diag.sqrt()).matrix();
+
+        //Update C evolutionary path
+        const double h_sig = (_p_sigma.squaredNorm() / _N /
+                             (1. - std::pow((1. - _c_sig),
+                                            (2. * (double)_count_eval / _lambda))))
+                             < (2. + 4. / (_N + 1.));
+        _p_c = (1. - _c_c) * _p_c + h_sig * std::sqrt(_c_c * (2. - _c_c) * _mu_eff)
+               * mean_step;
+
+        //Rank-mu update of the diagonal only
+        _elites.colwise() -= _mean_old;
+        _elites /= _sigma;
+        const Eigen::ArrayXd rank_mu =
+            (_elites.array().square().matrix() * _weights).array();
+
+        _C_diag = (1. - _c_1 - _c_mu) * _C_diag + _c_mu * rank_mu +
+                  _c_1 * (_p_c.array().square() +
+                          (1. - h_sig) * _c_c * (2. - _c_c) * _C_diag);
+
+        //Compute new sigma
+        _sigma *= std::exp(
+            std::min(0.6, (_c_sig / _d_sig) * (_p_sigma.norm() / _chiN - 1.)));
+
+        if(this->_trace)
+        {
+            std::cout << "Mean: " << std::endl << _mean << std::endl;
+            std::cout << "C diagonal: " << std::endl << _C_diag << std::endl;
+            std::cout << "sigma: " << std::endl << _sigma << std::endl;
+        }
+
+        return sample_population(gp_map);
+
+    }
+
+private:
+
+    Population<double, T> initialise_population(
+        std::shared_ptr<GPMap<double, T>> gp_map) override
+    {
+        return sample_population(gp_map);
+    }
+
+    Population<double, T> sample_population(std::shared_ptr<GPMap<double, T>> gp_map)
+    {
+
+        //Draw an N x lambda matrix of standard normals
+        for(Eigen::Index i = 0; i < _samples.size(); i++)
+            _samples.data()[i] = _gauss_distr.next();
+
+        //Scale each gene by its standard deviation
+        _samples = (_sigma * _C_diag.sqrt()).matrix().asDiagonal() * _samples;
+        _samples.colwise() += _mean;
+
+        std::vector<Genotype<double>> genotypes;
+        genotypes.reserve(this->_pop_size);
+
+        for(unsigned i = 0; i < this->_pop_size; i++)
+            genotypes.push_back(Genotype<double>(
+                std::vector<double>(_samples.col(i).data(),
+                                    _samples.col(i).data() + this->_num_genes)));
+
+        return Population<double, T>(genotypes, gp_map, this->_thread_pool.get());
+    }
+
+    Eigen::VectorXd calculate_weights() const
+    {
+        Eigen::VectorXd weights = Eigen::VectorXd::Zero(_mu);
+
+        //Weight creation procedure in pagmo
+        for(unsigned i = 0; i < _mu; i++)
+            weights(i) = std::log((double)_mu + 0.5) - std::log((double)i + 1);
+        weights /= weights.sum();
+
+        return weights;
+    }
+
+    SepCMAES* clone_impl() const override
+    {
+        return new SepCMAES(*this);
+    }
+
+    void reset() override
+    {
+        if(this->_seed.has_value())
+            _gauss_distr.set_seed(this->_seed.value());
+        else
+            _gauss_distr.randomly_seed();
+    }
+
+    Eigen::VectorXd _mean;
+    Eigen::VectorXd _mean_old;
+    double _sigma;
+    //Diagonal of the covariance matrix
+    Eigen::ArrayXd _C_diag;
+
+    double _N;
+    double _lambda;
+
+    unsigned _mu;
+    Eigen::VectorXd _weights;
+
+    double _mu_eff;
+    double _c_mu;
+    double _c_c;
+    double _c_sig;
+    double _c_1;
+    double _d_sig;
+    double _chiN;
+
+    Eigen::VectorXd _p_c;
+    Eigen::VectorXd _p_sigma;
+
+    unsigned _count_eval;
+
+    //Working matrices reused every generation
+    Eigen::MatrixXd _elites;
+    Eigen::MatrixXd _samples;
+
+    GaussianDistribution _gauss_distr;
+
+};
+
+static Factory<Optimiser<double, double>>::Registrar sep_cmaes_registrar("SepCMAES",
+    [](const JSON& json)
+    {return std::make_shared<SepCMAES<double>>(json);});
+
+} // namespace NeuroEvo
+
+#endif
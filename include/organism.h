@@ -5,6 +5,9 @@
     This class contains everything that constitutes
     an Organism, including its genotype, phenotype
     and genotype-phenotype map.
+    The genotype-phenotype map is shared by every organism
+    it was handed to rather than copied into each one,
+    so a large decoder is only held once per population.
 */
 
 #include <genotype/genotype.h>
@@ -22,24 +25,33 @@ class Organism {
 
 public:
 
-    Organism(const Genotype<G>& genotype, std::shared_ptr<GPMap<G, T>> gp_map) :
+    Organism(const Genotype<G>& genotype, std::shared_ptr<const GPMap<G, T>> gp_map) :
         _genotype(genotype.clone()),
-        _gp_map(gp_map->clone()),
+        _gp_map(gp_map),
         _phenotype(gp_map->map(*_genotype)),
         _fitness(std::nullopt),
         _domain_winner(false) {}
 
+    //Takes a phenotype that has already been mapped from the genotype by gp_map
+    Organism(const Genotype<G>& genotype, std::shared_ptr<const GPMap<G, T>> gp_map,
+             std::unique_ptr<Phenotype<T>> phenotype) :
+        _genotype(genotype.clone()),
+        _gp_map(gp_map),
+        _phenotype(std::move(phenotype)),
+        _fitness(std::nullopt),
+        _domain_winner(false) {}
+
     Organism(const JSON& json) :
         _genotype(std::make_unique<Genotype<G>>(
                      json.at({"genes"}).get<std::vector<G>>())),
-        _gp_map(Factory<GPMap<G, T>>::create(json.at({"GPMap"}))->clone()),
+        _gp_map(Factory<GPMap<G, T>>::create(json.at({"GPMap"}))),
         _phenotype(_gp_map->map(*_genotype)),
         _fitness(json.at({"fitness"})),
         _domain_winner(json.at({"domain_winner"})) {}
 
     Organism(const Organism& organism) :
         _genotype(organism.get_genotype().clone()),
-        _gp_map(organism._gp_map->clone()),
+        _gp_map(organism._gp_map),
         _phenotype(organism.get_phenotype().clone_phenotype()),
         _fitness(organism.get_fitness()),
         _domain_winner(organism._domain_winner) {}
@@ -47,7 +59,7 @@ public:
     Organism& operator=(const Organism& organism)
     {
         _genotype = organism.get_genotype().clone();
-        _gp_map = organism._gp_map->clone();
+        _gp_map = organism._gp_map;
         _phenotype = organism.get_phenotype().clone_phenotype();
         _fitness = organism.get_fitness();
         _domain_winner = organism._domain_winner;
@@ -89,6 +101,12 @@ public:
         return *_gp_map;
     }
 
+    //For building other organisms that map their genes the same way
+    std::shared_ptr<const GPMap<G, T>> get_shared_gp_map() const
+    {
+        return _gp_map;
+    }
+
     Phenotype<T>& get_phenotype() const
     {
         return *_phenotype;
@@ -107,7 +125,18 @@ public:
     //Creates new phenotype out of modified genotype
     void genesis()
     {
-        _phenotype.reset(_gp_map->map(*_genotype));
+        _gp_map->remap(*_genotype, _phenotype);
+    }
+
+    //Takes on the genes of the parent whilst keeping this organism's storage,
+    //which saves copying an organism to create a child. The organism is left
+    //unevaluated, and genesis needs to be called before the phenotype reflects
+    //the new genes, so a child can be mutated before its phenotype is built.
+    void inherit(const Organism& parent)
+    {
+        _genotype->genes_mut() = parent._genotype->genes();
+        _fitness = std::nullopt;
+        _domain_winner = false;
     }
 
     JSON to_json() const
@@ -139,7 +168,7 @@ public:
 private:
 
     std::unique_ptr<Genotype<G>> _genotype;
-    std::unique_ptr<GPMap<G, T>> _gp_map;
+    std::shared_ptr<const GPMap<G, T>> _gp_map;
     std::unique_ptr<Phenotype<T>> _phenotype;
 
     std::optional<double> _fitness;
@@ -67,6 +67,24 @@ public:
         return propogate(inputs);
     }
 
+    //The weights change every time the network is activated
+    bool batchable() const override
+    {
+        return false;
+    }
+
+    void activate_into(const std::vector<double>& inputs,
+                       std::vector<double>& outputs) override
+    {
+        if(_hebbs_spec.get_print_weights_to_file())
+        {
+            print_weights_to_file();
+            print_outputs_to_file();
+        }
+
+        propogate_into(inputs, outputs);
+    }
+
 protected:
 
     virtual HebbsNetwork* clone_impl() const override 
@@ -7,6 +7,7 @@
 
 #include <phenotype/neural_network/neuron.h>
 #include <vector>
+#include <Eigen/Dense>
 #include <data/json.h>
 
 namespace NeuroEvo {
@@ -32,10 +33,23 @@ public:
     virtual void set_learning_rates(const std::vector<double>& learning_rates) {}
 
     unsigned get_number_of_weights() const;
+    unsigned get_num_neurons() const;
     std::vector<double> get_weights() const;
     std::shared_ptr<ActivationFunction> get_activation_function() const;
 
     std::vector<double> evaluate(const std::vector<double>& inputs);
+    //outputs must not be inputs
+    void evaluate_into(const std::vector<double>& inputs, std::vector<double>& outputs);
+
+    //Whether the neurons keep no state between evaluations, so many inputs can
+    //be evaluated at once with evaluate_batch
+    bool batchable() const;
+
+    //Evaluates every column of inputs with one matrix product, writing the
+    //outputs of each column into the same column of outputs, which has to have
+    //a row for every neuron
+    void evaluate_batch(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                        Eigen::Ref<Eigen::MatrixXd> outputs) const;
 
     void reset();
 
@@ -57,6 +71,11 @@ protected:
 
     std::vector<std::unique_ptr<Neuron>> _neurons;
 
+    //The weights of each neuron make up one row, built by set_weights for
+    //evaluate_batch
+    Eigen::MatrixXd _weight_matrix;
+    Eigen::VectorXd _biases;
+
     void print_outputs(const std::vector<double>& outputs);
 
 private:
@@ -7,6 +7,7 @@
 
 #include <phenotype/neural_network/network_base.h>
 #include <phenotype/neural_network/layer.h>
+#include <array>
 
 namespace NeuroEvo {
 
@@ -24,6 +25,32 @@ public:
     virtual void propogate_learning_rates(const std::vector<double>& learning_rates) {}
 
     virtual std::vector<double> activate(const std::vector<double>& inputs) override;
+    virtual void activate_into(const std::vector<double>& inputs,
+                               std::vector<double>& outputs) override;
+
+    //Whether activate_batch can be used, which needs every layer to be
+    //batchable and activating the network to have no side effects, such as
+    //tracing
+    virtual bool batchable() const;
+
+    //Activates the network on every column of inputs at once, with a matrix
+    //product per layer, and writes the outputs of each column into the same
+    //column of outputs
+    void activate_batch(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                        Eigen::MatrixXd& outputs);
+
+    //Activates a batch of many networks of the same shape, where networks[i]
+    //activates the num_columns[i] columns of inputs after those of the networks
+    //before it. Each layer is evaluated for the whole batch before the next,
+    //with the hidden outputs of every network kept by the first.
+    static void activate_batch(const std::vector<Network*>& networks,
+                               const std::vector<Eigen::Index>& num_columns,
+                               const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                               Eigen::MatrixXd& outputs);
+
+    //Whether network has as many layers as this one, each with as many
+    //neurons, so the two can be activated in one batch
+    bool same_shape(const Network& network) const;
 
     void reset() override;
 
@@ -35,9 +62,15 @@ public:
 protected:
 
     std::vector<double> propogate(const std::vector<double>& inputs);
+    //outputs must not be inputs
+    void propogate_into(const std::vector<double>& inputs, std::vector<double>& outputs);
 
     std::vector<std::unique_ptr<Layer>> _layers;
 
+    //The outputs of the hidden layers, alternating between the two
+    std::array<std::vector<double>, 2> _hidden_outputs;
+    std::array<Eigen::MatrixXd, 2> _hidden_batch_outputs;
+
 private:
 
     JSON to_json_impl() const override;
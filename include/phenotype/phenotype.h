@@ -31,6 +31,14 @@ public:
 
     virtual std::vector<T> activate(
         const std::vector<double>& inputs = std::vector<double>()) = 0;
+
+    //Activates the phenotype and writes the result into outputs, reusing its
+    //memory, so a phenotype activated many times need not allocate every time.
+    //Phenotypes that can activate in place override this.
+    virtual void activate_into(const std::vector<double>& inputs, std::vector<T>& outputs)
+    {
+        outputs = activate(inputs);
+    }
     virtual void reset() = 0;
 
     virtual JSON to_json() const
@@ -65,6 +65,10 @@ public:
     //the weights from the genotype
     Phenotype<double>* build_network();
 
+    //Builds the network with the given weights. The builder is left untouched
+    //so GPMaps can call this from several threads at once.
+    Phenotype<double>* build_network(const std::vector<double>& weights) const;
+
     /* Builder functions */
     void make_recurrent();
     void add_layer(LayerSpec& layer_spec);
@@ -119,6 +123,9 @@ private:
 
     const std::vector<double> generate_init_weights() const;
 
+    //Weights are not propagated if init_weights is null
+    Phenotype<double>* create_network(const std::vector<double>* init_weights) const;
+
     JSON to_json_impl() const override;
     NetworkBuilder* clone_impl() const override;
 
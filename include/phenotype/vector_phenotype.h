@@ -27,6 +27,13 @@ public:
 
     void reset() override {}
 
+    //Overwrites the traits, reusing their storage
+    template <typename InputIt>
+    void assign_traits(InputIt first, InputIt last)
+    {
+        _traits.assign(first, last);
+    }
+
     void print(std::ostream& os) const override
     {
         os << "[";
@@ -59,7 +66,7 @@ private:
         return _traits;
     }
 
-    const std::vector<T> _traits;
+    std::vector<T> _traits;
 
 };
 
@@ -6,9 +6,20 @@
     It does so by taking a PhenotypeSpec (description
     of the phenotype), population size and a reference
     to the current generation.
+    The genes, fitnesses and domain winners are also stored
+    contiguously so that operations over the whole population
+    do not have to visit every organism. The genes form a
+    row-major matrix with a row for every organism, so every
+    organism must have the same number of genes.
+    If a thread pool is given, phenotypes are mapped from the
+    genotypes on the threads of the pool.
 */
 
 #include <organism.h>
+#include <util/bit_vector.h>
+#include <util/concurrency/thread_pool.h>
+#include <limits>
+#include <stdexcept>
 #include <genetic_operators/selection/selection.h>
 #include <genetic_operators/mutation/mutator.h>
 #include <phenotype/phenotype_specs/phenotype_spec.h>
@@ -23,22 +34,52 @@ public:
     Population() = default;
 
     Population(const std::vector<Genotype<G>>& genotypes,
-               std::shared_ptr<GPMap<G, T>> gp_map)
+               std::shared_ptr<GPMap<G, T>> gp_map,
+               ThreadPool* thread_pool = nullptr)
     {
-        for(const auto& genotype : genotypes)
-            _organisms.push_back(Organism(genotype, gp_map));
+        _organisms.reserve(genotypes.size());
+
+        if(thread_pool == nullptr)
+            for(const auto& genotype : genotypes)
+                _organisms.push_back(Organism<G, T>(genotype, gp_map));
+        else
+        {
+            std::vector<std::unique_ptr<Phenotype<T>>> phenotypes(genotypes.size());
+            thread_pool->parallel_for(genotypes.size(),
+                                      [&genotypes, &gp_map, &phenotypes](std::size_t i)
+                                      {
+                                          phenotypes[i].reset(
+                                              gp_map->map(genotypes[i]));
+                                      });
+
+            for(std::size_t i = 0; i < genotypes.size(); i++)
+                _organisms.push_back(Organism<G, T>(genotypes[i], gp_map,
+                                                    std::move(phenotypes[i])));
+        }
+
+        sync_organisms();
     }
 
-    Population(const std::vector<Organism<G, T>>& organisms) :
+    Population(const std::vector<Organism<G, T>>& organisms,
+               ThreadPool* thread_pool = nullptr) :
         _organisms(organisms)
     {
-        genesis();
+        genesis(thread_pool);
+        sync_organisms();
     }
 
-    void genesis()
+    //Rebuilds the phenotypes of all organisms from their genotypes
+    void genesis(ThreadPool* thread_pool = nullptr)
     {
-        for(auto& org : _organisms)
-            org.genesis();
+        if(thread_pool == nullptr)
+            for(auto& org : _organisms)
+                org.genesis();
+        else
+            thread_pool->parallel_for(_organisms.size(),
+                                      [this](std::size_t i)
+                                      {
+                                          _organisms[i].genesis();
+                                      });
     }
 
     const std::vector<Organism<G, T>>& get_organisms() const
@@ -46,28 +87,66 @@ public:
         return _organisms;
     }
 
+    //If the genes, fitness or winner status of the organism are changed through
+    //this reference, refresh_organism must be called afterwards
     Organism<G, T>& get_mutable_organism(const std::size_t org)
     {
         return _organisms.at(org);
     }
 
+    void set_organism(const std::size_t org, Organism<G, T> organism)
+    {
+        _organisms.at(org) = std::move(organism);
+        refresh_organism(org);
+    }
+
+    //Updates the stored genes, fitness and winner status of an organism
+    void refresh_organism(const std::size_t org)
+    {
+        const auto& organism = _organisms.at(org);
+        const std::vector<G>& genes = organism.get_genotype().genes();
+        if(genes.size() != _num_genes)
+            throw std::invalid_argument("Every organism of a population must have " +
+                                        std::to_string(_num_genes) + " genes");
+        std::copy(genes.begin(), genes.end(), _genes.begin() + org * _num_genes);
+        _fitnesses[org] = organism.get_fitness().value_or(
+            std::numeric_limits<double>::quiet_NaN());
+        _winners.set(org, organism.is_domain_winner());
+    }
+
     unsigned get_size() const
     {
         return _organisms.size();
     }
 
-    const std::vector<double> get_fitnesses() const
+    //The genes of organism org are in row org, from org * get_num_genes()
+    const std::vector<G>& get_genes() const
     {
-        std::vector<double> fitnesses(_organisms.size());
-        for(std::size_t i = 0; i < _organisms.size(); i++)
-            fitnesses[i] = _organisms[i].get_fitness().value();
-        return fitnesses;
+        return _genes;
+    }
+
+    std::size_t get_num_genes() const
+    {
+        return _num_genes;
+    }
+
+    //Organisms that have not been evaluated have a NaN fitness
+    const std::vector<double>& get_fitnesses() const
+    {
+        return _fitnesses;
+    }
+
+    //A bit is set for every organism that is a domain winner
+    const BitVector& get_domain_winners() const
+    {
+        return _winners;
     }
 
     void set_organism_fitness(const std::size_t org, const double fitness,
                               const double domain_completion_fitness)
     {
         _organisms.at(org).set_fitness(fitness, domain_completion_fitness);
+        refresh_organism(org);
     }
 
     void organism_genesis(const std::size_t org)
@@ -77,12 +156,12 @@ public:
 
     const Organism<G, T>& get_fittest_org() const
     {
-        double best_fitness = _organisms[0].get_fitness().value();
+        double best_fitness = _fitnesses[0];
         std::size_t best_org_index = 0;
-        for(unsigned i = 1; i < _organisms.size(); i++)
-            if(_organisms[i].get_fitness().value() > best_fitness)
+        for(std::size_t i = 1; i < _fitnesses.size(); i++)
+            if(_fitnesses[i] > best_fitness)
             {
-                best_fitness = _organisms[i].get_fitness().value();
+                best_fitness = _fitnesses[i];
                 best_org_index = i;
             }
         return _organisms[best_org_index];
@@ -97,8 +176,24 @@ public:
 
 private:
 
+    void sync_organisms()
+    {
+        _num_genes = _organisms.empty() ? 0 :
+            _organisms.front().get_genotype().genes().size();
+        _genes.resize(_organisms.size() * _num_genes);
+        _fitnesses.resize(_organisms.size());
+        _winners = BitVector(_organisms.size());
+        for(std::size_t i = 0; i < _organisms.size(); i++)
+            refresh_organism(i);
+    }
+
     std::vector<Organism<G, T>> _organisms;
 
+    std::vector<G> _genes;
+    std::size_t _num_genes = 0;
+    std::vector<double> _fitnesses;
+    BitVector _winners;
+
 };
 
 } // namespace NeuroEvo
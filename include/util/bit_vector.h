@@ -0,0 +1,154 @@
+#ifndef _BIT_VECTOR_H_
+#define _BIT_VECTOR_H_
+
+/*
+ * A vector of bits packed into 64-bit words.
+ * Unlike std::vector<bool>, the underlying words are exposed so that
+ * operations such as mutation and matching can work on 64 bits at a time.
+ * Bits past the end of the vector in the last word are always kept at 0 so
+ * that whole words can be compared and counted.
+ */
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace NeuroEvo {
+
+class BitVector
+{
+
+public:
+
+    typedef std::uint64_t word_type;
+    static constexpr std::size_t BITS_PER_WORD = 64;
+
+    BitVector(const std::size_t size = 0, const bool value = false);
+    BitVector(const std::vector<bool>& bits);
+
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    bool operator[](const std::size_t i) const
+    {
+        return (_words[i / BITS_PER_WORD] >> (i % BITS_PER_WORD)) & 1;
+    }
+
+    bool at(const std::size_t i) const;
+
+    void set(const std::size_t i, const bool value)
+    {
+        const word_type mask = word_type(1) << (i % BITS_PER_WORD);
+        if(value)
+            _words[i / BITS_PER_WORD] |= mask;
+        else
+            _words[i / BITS_PER_WORD] &= ~mask;
+    }
+
+    void flip(const std::size_t i)
+    {
+        _words[i / BITS_PER_WORD] ^= word_type(1) << (i % BITS_PER_WORD);
+    }
+
+    //Number of bits set to 1
+    std::size_t count() const;
+
+    //Index of the first bit set to 1, or size() if there is none
+    std::size_t find_first() const;
+
+    //Number of positions at which the two vectors differ
+    std::size_t hamming_distance(const BitVector& other) const;
+
+    //Overwrites the vector with the given bits, reusing storage
+    void assign(const std::vector<bool>& bits);
+
+    const std::vector<word_type>& words() const
+    {
+        return _words;
+    }
+
+    //Anything written past the last bit must be removed with clear_padding
+    std::vector<word_type>& words_mut()
+    {
+        return _words;
+    }
+
+    //Sets the unused bits of the last word to 0
+    void clear_padding();
+
+    std::vector<bool> to_vector() const;
+
+    bool operator==(const BitVector& other) const = default;
+
+    class const_iterator
+    {
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef bool value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef bool reference;
+
+        const_iterator() = default;
+
+        const_iterator(const BitVector* bits, const std::size_t pos) :
+            _bits(bits),
+            _pos(pos) {}
+
+        bool operator*() const
+        {
+            return (*_bits)[_pos];
+        }
+
+        const_iterator& operator++()
+        {
+            _pos++;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator it = *this;
+            _pos++;
+            return it;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return _pos == other._pos;
+        }
+
+    private:
+
+        const BitVector* _bits = nullptr;
+        std::size_t _pos = 0;
+    };
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, _size);
+    }
+
+private:
+
+    std::size_t _size;
+    std::vector<word_type> _words;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef _CLONE_POOL_H_
+#define _CLONE_POOL_H_
+
+/*
+ * Hands out copies of an object with state, such as a network or a domain, to
+ * threads that each need one to themselves. A copy is returned to the pool
+ * when its lease ends so it can be reused, therefore no more copies are made
+ * than there have been threads using the pool at once.
+ */
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace NeuroEvo {
+
+template <typename T>
+class ClonePool
+{
+
+public:
+
+    //Owns a copy until it goes out of scope
+    class Lease
+    {
+
+    public:
+
+        Lease(ClonePool& pool, std::unique_ptr<T> clone) :
+            _pool(pool),
+            _clone(std::move(clone)) {}
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ~Lease()
+        {
+            _pool.give_back(std::move(_clone));
+        }
+
+        T& operator*() const
+        {
+            return *_clone;
+        }
+
+        T* operator->() const
+        {
+            return _clone.get();
+        }
+
+    private:
+
+        ClonePool& _pool;
+        std::unique_ptr<T> _clone;
+
+    };
+
+    ClonePool(std::function<std::unique_ptr<T>()> make_clone) :
+        _make_clone(make_clone) {}
+
+    ClonePool(const ClonePool&) = delete;
+    ClonePool& operator=(const ClonePool&) = delete;
+
+    Lease borrow()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_spares_mutex);
+            if(!_spares.empty())
+            {
+                std::unique_ptr<T> clone = std::move(_spares.back());
+                _spares.pop_back();
+                return Lease(*this, std::move(clone));
+            }
+        }
+
+        return Lease(*this, _make_clone());
+    }
+
+private:
+
+    void give_back(std::unique_ptr<T> clone)
+    {
+        std::lock_guard<std::mutex> lock(_spares_mutex);
+        _spares.push_back(std::move(clone));
+    }
+
+    const std::function<std::unique_ptr<T>()> _make_clone;
+
+    std::vector<std::unique_ptr<T>> _spares;
+    std::mutex _spares_mutex;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
@@ -17,7 +17,6 @@ struct RunArguments
     unsigned& num_winners;
     unsigned& total_winners_gens;
     bool trace = true;
-    bool domain_parallel = false;
 };
 
 } // namespace NeuroEvo
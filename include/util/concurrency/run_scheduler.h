@@ -36,7 +36,6 @@ public:
                               unsigned&,
                               bool&,
                               unsigned&,
-                              const bool,
                               const bool))
 
     {
@@ -99,7 +98,7 @@ public:
                                 std::ref(_run_args.num_winners),
                                 std::ref(finished_flags[thread_index]),
                                 std::ref(_run_args.total_winners_gens),
-                                _run_args.trace, _run_args.domain_parallel);
+                                _run_args.trace);
 
                         num_runs_started++;
 
@@ -0,0 +1,71 @@
+#ifndef _SPSC_QUEUE_H_
+#define _SPSC_QUEUE_H_
+
+/*
+ * A bounded lock-free queue for exactly one producer thread and one consumer
+ * thread. Neither side ever blocks: pushing to a full queue and popping from
+ * an empty queue both fail immediately.
+ */
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+namespace NeuroEvo {
+
+template <typename T>
+class SPSCQueue
+{
+
+public:
+
+    //One slot is always left empty to tell a full queue from an empty one
+    SPSCQueue(const std::size_t capacity) :
+        _slots(capacity + 1),
+        _head(0),
+        _tail(0) {}
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    //Called by the producer only
+    bool try_push(T item)
+    {
+        const std::size_t tail = _tail.load(std::memory_order_relaxed);
+        const std::size_t next_tail = (tail + 1) % _slots.size();
+
+        if(next_tail == _head.load(std::memory_order_acquire))
+            return false;
+
+        _slots[tail] = std::move(item);
+        _tail.store(next_tail, std::memory_order_release);
+        return true;
+    }
+
+    //Called by the consumer only
+    std::optional<T> try_pop()
+    {
+        const std::size_t head = _head.load(std::memory_order_relaxed);
+
+        if(head == _tail.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        std::optional<T> item = std::move(_slots[head]);
+        _slots[head].reset();
+        _head.store((head + 1) % _slots.size(), std::memory_order_release);
+        return item;
+    }
+
+private:
+
+    std::vector<std::optional<T>> _slots;
+
+    //Kept on separate cache lines so the producer and consumer do not contend
+    alignas(64) std::atomic<std::size_t> _head;
+    alignas(64) std::atomic<std::size_t> _tail;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+/*
+ * A fixed set of worker threads that loops over ranges of indices in parallel.
+ * The thread calling parallel_for works through the indices alongside the
+ * workers and never waits on a worker that has not started, so parallel_for
+ * can be called from several threads at once and from inside another
+ * parallel_for without deadlocking.
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NeuroEvo {
+
+class ThreadPool
+{
+
+public:
+
+    ThreadPool(const unsigned num_threads = std::thread::hardware_concurrency());
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    //Calls func(i) for every i in [0, n) and blocks until all calls have
+    //returned. The first exception thrown by func is rethrown here once the
+    //remaining calls have been abandoned.
+    void parallel_for(const std::size_t n,
+                      const std::function<void(const std::size_t)>& func);
+
+    unsigned get_num_threads() const;
+
+private:
+
+    void work();
+
+    std::vector<std::thread> _workers;
+
+    std::deque<std::function<void()>> _tasks;
+    std::mutex _tasks_mutex;
+    std::condition_variable _tasks_cv;
+    bool _stopping;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
@@ -39,7 +39,7 @@ public:
         _width(matrix.at(0).size()),
         _matrix(flatten(matrix)) {}
 
-    Matrix operator*(const Matrix& m) 
+    Matrix operator*(const Matrix& m) const
     {
 
         //Check for valid matrix multiplication
@@ -39,8 +39,9 @@ public:
     //Load python module
     void initialise()
     {
-        //Initialise python interpreter
-        Py_Initialize();
+        //Initialise python interpreter, once for every module
+        if(!Py_IsInitialized())
+            Py_Initialize();
 
         //Add module path to python interpreter
         std::string import_command = "import sys; sys.path.insert(0, '" + _module_path
@@ -81,7 +82,10 @@ public:
             return return_tuple;
         }
         else
+        {
+            Py_DECREF(func_return);
             return std::make_tuple();
+        }
     }
 
 private:
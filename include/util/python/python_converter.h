@@ -8,6 +8,7 @@
 #include <Python.h>
 #include <iostream>
 #include <map>
+#include <vector>
 
 namespace NeuroEvo {
 
@@ -119,6 +120,23 @@ static PyObject* convert(bool v) {
 }
 };
 
+//Memory owned by C++ that Python can read and write in place through the buffer
+//protocol, as a memoryview of doubles. The memory has to outlive any use of the
+//view on the Python side.
+struct PythonBuffer
+{
+    double* data;
+    std::size_t size;
+};
+
+template <>
+struct Converter<PythonBuffer> {
+static PyObject* convert(PythonBuffer v) {
+    return PyMemoryView_FromMemory(reinterpret_cast<char*>(v.data),
+                                   v.size * sizeof(double), PyBUF_WRITE);
+}
+};
+
 template <typename T>
 struct Converter<std::vector<T>>
 {
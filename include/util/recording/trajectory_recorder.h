@@ -0,0 +1,129 @@
+#ifndef _TRAJECTORY_RECORDER_H_
+#define _TRAJECTORY_RECORDER_H_
+
+/*
+ * Records the trajectory of each episode, the observation, action and reward
+ * of every step, to a binary file. An episode is collected in a buffer by the
+ * thread running it and handed to a background thread that writes it out, so
+ * recording a step only copies a few values into memory that has already been
+ * allocated. The buffers of written episodes are reused by later episodes.
+ *
+ * The file starts with the bytes NETR and a u32 version, followed by a block
+ * for every episode of
+ *     u32 observation size, u32 action size, u64 number of steps,
+ *     f64 observations..., f64 actions..., f64 rewards...
+ * in native byte order, where each column holds the values of every step one
+ * after the other. scripts/trajectories.py reads these files.
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace NeuroEvo {
+
+//The observations, actions and rewards of one episode, column by column
+class Trajectory
+{
+
+public:
+
+    Trajectory(const std::size_t reserved_steps = 0);
+
+    //The observation an action was chosen from and the action, the sizes of
+    //which are taken from the first step
+    void record_step(const std::vector<double>& observation,
+                     const std::vector<double>& action)
+    {
+        if(_num_steps == 0)
+            set_sizes(observation.size(), action.size());
+        _observations.insert(_observations.end(), observation.begin(), observation.end());
+        _actions.insert(_actions.end(), action.begin(), action.end());
+        _num_steps++;
+    }
+
+    //The reward received for the last action
+    void record_reward(const double reward)
+    {
+        _rewards.push_back(reward);
+    }
+
+    //Empties the trajectory, keeping the memory for the next episode
+    void clear();
+
+    uint32_t get_observation_size() const;
+    uint32_t get_action_size() const;
+    uint64_t get_num_steps() const;
+
+    const std::vector<double>& get_observations() const;
+    const std::vector<double>& get_actions() const;
+    const std::vector<double>& get_rewards() const;
+
+private:
+
+    //Sets the sizes and reserves the columns on the first step
+    void set_sizes(const std::size_t observation_size, const std::size_t action_size);
+
+    std::size_t _reserved_steps;
+
+    uint32_t _observation_size;
+    uint32_t _action_size;
+    uint64_t _num_steps;
+
+    std::vector<double> _observations;
+    std::vector<double> _actions;
+    std::vector<double> _rewards;
+
+};
+
+class TrajectoryRecorder
+{
+
+public:
+
+    //Opens file_name, replacing anything already there, and starts the writer
+    TrajectoryRecorder(const std::string& file_name,
+                       const std::size_t reserved_steps = 1000);
+
+    TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+    TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+    //Writes every trajectory that has been handed over and closes the file
+    ~TrajectoryRecorder();
+
+    //An empty trajectory to record an episode into
+    Trajectory start();
+
+    //Hands a trajectory over to be written
+    void finish(Trajectory&& trajectory);
+
+    const std::string& get_file_name() const;
+
+private:
+
+    void write_trajectories();
+    void write(const Trajectory& trajectory);
+
+    const std::string _file_name;
+    std::ofstream _file;
+    const std::size_t _reserved_steps;
+
+    std::mutex _mutex;
+    std::condition_variable _trajectory_finished;
+    std::deque<Trajectory> _finished;
+    //Trajectories that have been written, kept for their memory
+    std::vector<Trajectory> _spares;
+    bool _stop;
+
+    std::thread _writer;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _ALIAS_TABLE_H_
+#define _ALIAS_TABLE_H_
+
+/*
+ * A Walker/Vose alias table for sampling indices from a discrete distribution.
+ * The table is built in O(n) from a vector of non-negative weights after which
+ * every draw is O(1) and only requires a single uniform random number.
+ */
+
+#include <vector>
+#include <cstddef>
+
+namespace NeuroEvo {
+
+class AliasTable
+{
+
+public:
+
+    AliasTable() = default;
+    AliasTable(const std::vector<double>& weights);
+
+    //Rebuilds the table from a new set of weights, storage is reused between
+    //builds. If the weights sum to 0 every index is equally likely.
+    void build(const std::vector<double>& weights);
+
+    //Draws an index given a uniform random number in [0, 1)
+    std::size_t sample(const double uniform_rand) const;
+
+    std::size_t size() const;
+
+private:
+
+    //Probability of keeping column i rather than taking its alias
+    std::vector<double> _prob;
+    std::vector<std::size_t> _alias;
+
+    //Work lists used during the build
+    std::vector<std::size_t> _small;
+    std::vector<std::size_t> _large;
+    std::vector<double> _scaled;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
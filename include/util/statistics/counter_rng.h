@@ -0,0 +1,97 @@
+#ifndef _COUNTER_RNG_H_
+#define _COUNTER_RNG_H_
+
+/*
+ * A counter-based random number generator built on Philox4x32-10
+ * (Salmon et al. 2011).
+ * Every output is a pure function of a key (the seed), a stream and a counter.
+ * This means any draw can be computed directly without stepping through a
+ * sequence, and independent streams can be handed to runs, generations,
+ * organisms or trials without sharing any state between threads.
+ * The generator object itself is only a few words in size, so seeding and
+ * copying it is cheap.
+ * It satisfies UniformRandomBitGenerator so it can drive the std distributions.
+ */
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+namespace NeuroEvo {
+
+class CounterRNG
+{
+
+public:
+
+    typedef std::uint32_t result_type;
+
+    CounterRNG(const std::uint64_t seed = 0, const std::uint64_t stream = 0);
+
+    //Restarts the generator at the beginning of the given stream
+    void seed(const std::uint64_t seed, const std::uint64_t stream = 0);
+
+    result_type operator()()
+    {
+        if(_buffer_pos == _buffer.size())
+        {
+            _buffer = philox(_key, _stream, _counter++);
+            _buffer_pos = 0;
+        }
+        return _buffer[_buffer_pos++];
+    }
+
+    void discard(unsigned long long n);
+
+    static constexpr result_type min()
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    //Stateless draws
+    //128 random bits for a given (seed, stream, counter)
+    static std::array<std::uint32_t, 4> philox(const std::uint64_t seed,
+                                               const std::uint64_t stream,
+                                               const std::uint64_t counter);
+    //64 random bits for a given (seed, stream, counter)
+    static std::uint64_t draw(const std::uint64_t seed, const std::uint64_t stream,
+                              const std::uint64_t counter);
+    //Uniform double in [0, 1) for a given (seed, stream, counter)
+    static double uniform(const std::uint64_t seed, const std::uint64_t stream,
+                          const std::uint64_t counter);
+
+    //Derives the seed of a sub stream from a parent seed and a list of ids,
+    //e.g. derive_seed(seed, {run, generation, organism, trial}).
+    //The result only depends on the arguments, not on the order in which
+    //streams are requested, so it is the same regardless of thread count.
+    static std::uint64_t derive_seed(const std::uint64_t seed,
+                                     std::initializer_list<std::uint64_t> ids);
+
+    //A generator local to the calling thread seeded once from
+    //std::random_device. Used wherever a random seed is required.
+    static CounterRNG& thread_local_rng();
+
+    //A fresh random seed drawn from the thread local generator
+    static std::uint64_t random_seed();
+
+private:
+
+    std::uint64_t _key;
+    std::uint64_t _stream;
+    std::uint64_t _counter;
+
+    //Outputs of the last block that have not been handed out yet
+    std::array<std::uint32_t, 4> _buffer;
+    std::size_t _buffer_pos;
+
+};
+
+} // namespace NeuroEvo
+
+#endif
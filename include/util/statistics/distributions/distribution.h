@@ -6,12 +6,15 @@
     interface for a distribution.
     It allows for the setting and modifcation of seeds and returns
     a value of type T according to some distribution in the sub class.
+    Random bits come from a counter-based generator so that seeding is cheap
+    and distributions can be created freely on any thread.
 */
 
 #include <random>
 #include <optional>
 #include <memory>
 #include <data/json.h>
+#include <util/statistics/counter_rng.h>
 
 namespace NeuroEvo {
 
@@ -27,10 +30,8 @@ public:
         // Otherwise seed randomly
         if(seed)
             _rng.seed(*seed);
-        else {
-            std::random_device rand_dev;
-            _rng.seed(rand_dev());
-        }
+        else
+            _rng.seed(CounterRNG::random_seed());
 
     }
 
@@ -49,8 +50,7 @@ public:
 
     void randomly_seed()
     {
-        std::random_device rand_dev;
-        _rng.seed(rand_dev());
+        _rng.seed(CounterRNG::random_seed());
         reset();
     }
 
@@ -75,7 +75,7 @@ protected:
     virtual JSON to_json_impl() const = 0;
 
     std::optional<unsigned> _seed;
-    std::mt19937 _rng;
+    CounterRNG _rng;
 
 };
 
@@ -21,8 +21,12 @@ public:
     double next() override;
 
     //Functional call
+    //No distribution is constructed, the value is computed directly from the
+    //seed and counter. Draws with the same seed but different counters are
+    //independent of one another.
     static double get(const double lower_bound, const double upper_bound,
-                      const std::optional<unsigned> seed = std::nullopt);
+                      const std::optional<unsigned> seed = std::nullopt,
+                      const unsigned long counter = 0);
 
 private:
 
@@ -0,0 +1,30 @@
+# Writes the dataset files read by Dataset, see
+# include/domains/dataset/dataset.h for the file layout
+
+import struct
+
+import numpy as np
+
+
+FILE_MAGIC = b'NEDS'
+FILE_VERSION = 1
+
+
+# Write a dataset of inputs and targets, each with one row per example
+def write_dataset(file_path: str, inputs, targets) -> None:
+
+    inputs = np.asarray(inputs, dtype=np.float64)
+    targets = np.asarray(targets, dtype=np.float64)
+    if inputs.ndim == 1:
+        inputs = inputs.reshape(-1, 1)
+    if targets.ndim == 1:
+        targets = targets.reshape(-1, 1)
+
+    if inputs.shape[0] != targets.shape[0]:
+        raise ValueError('There must be the same number of inputs and targets')
+
+    with open(file_path, 'wb') as f:
+        f.write(FILE_MAGIC)
+        f.write(struct.pack('=IIIQ', FILE_VERSION, inputs.shape[1],
+                            targets.shape[1], inputs.shape[0]))
+        f.write(np.hstack((inputs, targets)).tobytes())
@@ -0,0 +1,66 @@
+# Reads the trajectory files written by TrajectoryRecorder, see
+# include/util/recording/trajectory_recorder.h for the file layout
+#
+# python3 trajectories.py *trajectory file*
+# prints the number of steps and total reward of every recorded episode
+
+import struct
+import sys
+from typing import List, NamedTuple
+
+import numpy as np
+
+
+class Trajectory(NamedTuple):
+    # One row per step
+    observations: np.ndarray
+    actions: np.ndarray
+    rewards: np.ndarray
+
+
+FILE_MAGIC = b'NETR'
+FILE_VERSION = 1
+
+EPISODE_HEADER = struct.Struct('=IIQ')
+
+
+# Read every episode of a trajectory file
+def read_trajectories(file_path: str) -> List[Trajectory]:
+
+    with open(file_path, 'rb') as f:
+        data = f.read()
+
+    if data[:4] != FILE_MAGIC:
+        raise ValueError(file_path + ' is not a trajectory file')
+    version, = struct.unpack_from('=I', data, 4)
+    if version != FILE_VERSION:
+        raise ValueError('Cannot read version ' + str(version) +
+                         ' trajectory files')
+
+    trajectories = []
+    offset = 8
+
+    while offset < len(data):
+
+        obs_size, action_size, num_steps = \
+            EPISODE_HEADER.unpack_from(data, offset)
+        offset += EPISODE_HEADER.size
+
+        columns = []
+        for size in (obs_size, action_size, 1):
+            column = np.frombuffer(data, dtype=np.float64,
+                                   count=num_steps * size, offset=offset)
+            columns.append(column.reshape(num_steps, size))
+            offset += column.nbytes
+
+        trajectories.append(Trajectory(columns[0], columns[1],
+                                       columns[2].reshape(num_steps)))
+
+    return trajectories
+
+
+if __name__ == '__main__':
+
+    for i, trajectory in enumerate(read_trajectories(sys.argv[1])):
+        print('Episode:', i, ' Steps:', len(trajectory.rewards),
+              ' Total reward:', trajectory.rewards.sum())
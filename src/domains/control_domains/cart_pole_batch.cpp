@@ -0,0 +1,176 @@
+#include <domains/control_domains/cart_pole_batch.h>
+
+namespace NeuroEvo {
+
+CartPoleBatch::CartPoleBatch(const double gravity, const double cart_mass,
+                             const double pole_mass, const double pole_half_length,
+                             const double tau, const double boundary,
+                             const double failure_angle) :
+    _gravity(gravity),
+    _pole_mass(pole_mass),
+    _total_mass(cart_mass + pole_mass),
+    _pole_half_length(pole_half_length),
+    _polemass_length(pole_mass * pole_half_length),
+    _tau(tau),
+    _boundary(boundary),
+    _failure_angle(failure_angle) {}
+
+void CartPoleBatch::reset(const std::size_t num_carts)
+{
+    _x.setZero(num_carts);
+    _x_dot.setZero(num_carts);
+    _theta.setZero(num_carts);
+    _theta_dot.setZero(num_carts);
+    _running.setOnes(num_carts);
+    _steps.setZero(num_carts);
+
+    _carts.resize(num_carts);
+    _slots.resize(num_carts);
+    for(std::size_t i = 0; i < num_carts; i++)
+    {
+        _carts[i] = i;
+        _slots[i] = i;
+    }
+    _removed.assign(num_carts, false);
+    _removed_steps.assign(num_carts, 0);
+
+    _cos_theta.resize(num_carts);
+    _sin_theta.resize(num_carts);
+    _temp.resize(num_carts);
+    _thetaacc.resize(num_carts);
+    _xacc.resize(num_carts);
+    _dt.resize(num_carts);
+}
+
+void CartPoleBatch::set_state(const std::size_t cart, const double x,
+                              const double x_dot, const double theta,
+                              const double theta_dot)
+{
+    _x(cart) = x;
+    _x_dot(cart) = x_dot;
+    _theta(cart) = theta;
+    _theta_dot(cart) = theta_dot;
+}
+
+void CartPoleBatch::step(const Eigen::ArrayXd& force)
+{
+    //The same constant as SingleCartPole so the carts follow the same paths
+    const double four_thirds = 1.333333333333;
+
+    _cos_theta = _theta.cos();
+    _sin_theta = _theta.sin();
+
+    _temp = (force + _polemass_length * _theta_dot * _theta_dot * _sin_theta) /
+            _total_mass;
+
+    _thetaacc = (_gravity * _sin_theta - _cos_theta * _temp) /
+                (_pole_half_length * (four_thirds - _pole_mass * _cos_theta *
+                                      _cos_theta / _total_mass));
+
+    _xacc = _temp - _polemass_length * _thetaacc * _cos_theta / _total_mass;
+
+    //Update the four state variables using Euler's method, failed carts have a
+    //time step of 0 so they stay where they are
+    _dt = _tau * _running;
+    _x += _dt * _x_dot;
+    _x_dot += _dt * _xacc;
+    _theta += _dt * _theta_dot;
+    _theta_dot += _dt * _thetaacc;
+
+    _steps += _running;
+
+    //Check for failure
+    _running *= ((_x.abs() <= _boundary) && (_theta.abs() <= _failure_angle))
+                    .cast<double>();
+
+    if(_running.sum() <= _running.size() / 2)
+        compact();
+}
+
+std::size_t CartPoleBatch::get_num_slots() const
+{
+    return _x.size();
+}
+
+std::size_t CartPoleBatch::get_cart(const std::size_t slot) const
+{
+    return _carts[slot];
+}
+
+bool CartPoleBatch::running(const std::size_t slot) const
+{
+    return _running(slot) != 0.;
+}
+
+bool CartPoleBatch::failed(const std::size_t cart) const
+{
+    return _removed[cart] || !running(_slots[cart]);
+}
+
+bool CartPoleBatch::all_failed() const
+{
+    return (_running == 0.).all();
+}
+
+unsigned CartPoleBatch::get_steps(const std::size_t cart) const
+{
+    if(_removed[cart])
+        return _removed_steps[cart];
+    return _steps(_slots[cart]);
+}
+
+const Eigen::ArrayXd& CartPoleBatch::get_x() const
+{
+    return _x;
+}
+
+const Eigen::ArrayXd& CartPoleBatch::get_x_dot() const
+{
+    return _x_dot;
+}
+
+const Eigen::ArrayXd& CartPoleBatch::get_theta() const
+{
+    return _theta;
+}
+
+const Eigen::ArrayXd& CartPoleBatch::get_theta_dot() const
+{
+    return _theta_dot;
+}
+
+void CartPoleBatch::compact()
+{
+    std::size_t num_kept = 0;
+
+    for(std::size_t i = 0; i < _carts.size(); i++)
+    {
+        const std::size_t cart = _carts[i];
+
+        if(_running(i) == 0.)
+        {
+            _removed[cart] = true;
+            _removed_steps[cart] = _steps(i);
+            continue;
+        }
+
+        _x(num_kept) = _x(i);
+        _x_dot(num_kept) = _x_dot(i);
+        _theta(num_kept) = _theta(i);
+        _theta_dot(num_kept) = _theta_dot(i);
+        _steps(num_kept) = _steps(i);
+        _carts[num_kept] = cart;
+        _slots[cart] = num_kept;
+        num_kept++;
+    }
+
+    _x.conservativeResize(num_kept);
+    _x_dot.conservativeResize(num_kept);
+    _theta.conservativeResize(num_kept);
+    _theta_dot.conservativeResize(num_kept);
+    _steps.conservativeResize(num_kept);
+    _running.setOnes(num_kept);
+    _carts.resize(num_kept);
+}
+
+} // namespace NeuroEvo
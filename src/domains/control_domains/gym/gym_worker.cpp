@@ -0,0 +1,299 @@
+#include <domains/control_domains/gym/gym_worker.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace NeuroEvo {
+
+namespace {
+
+//Appends the bytes of value to message
+template <typename T>
+void pack(std::vector<char>& message, const T& value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    message.insert(message.end(), bytes, bytes + sizeof(T));
+}
+
+void pack_string(std::vector<char>& message, const std::string& str)
+{
+    pack(message, static_cast<uint32_t>(str.size()));
+    message.insert(message.end(), str.begin(), str.end());
+}
+
+//A worker that has died would otherwise kill this process with SIGPIPE on the
+//next command written to it, rather than failing the write with EPIPE
+void ignore_sigpipe()
+{
+    static std::once_flag ignored;
+    std::call_once(ignored, []() { std::signal(SIGPIPE, SIG_IGN); });
+}
+
+} // namespace
+
+GymWorker::GymWorker(const std::string& gym_env_id,
+                     const std::map<const std::string, const double>& kwargs) :
+    _num_envs(0)
+{
+
+    ignore_sigpipe();
+
+    //The ends are closed on exec so workers started later do not hold on to
+    //the pipes of earlier workers
+    int command_pipe[2];
+    int reply_pipe[2];
+    if(::pipe2(command_pipe, O_CLOEXEC) == -1 || ::pipe2(reply_pipe, O_CLOEXEC) == -1)
+        throw std::runtime_error("Could not create the pipes to a gym worker: " +
+                                 std::string(std::strerror(errno)));
+
+    const std::string script = std::string(NEURO_EVO_CMAKE_SRC_DIR) +
+        "/include/domains/control_domains/gym/gym_worker.py";
+
+    //posix_spawnp rather than fork and exec, as other threads may hold locks
+    //that a forked child would never see released. The pipe ends are put on
+    //the standard input and output of the worker and the rest are closed on
+    //exec.
+    posix_spawn_file_actions_t file_actions;
+    int error = ::posix_spawn_file_actions_init(&file_actions);
+    if(error == 0)
+    {
+        error = ::posix_spawn_file_actions_adddup2(&file_actions, command_pipe[0],
+                                                   STDIN_FILENO);
+        if(error == 0)
+            error = ::posix_spawn_file_actions_adddup2(&file_actions, reply_pipe[1],
+                                                       STDOUT_FILENO);
+
+        char* const argv[] = {const_cast<char*>("python3"),
+                              const_cast<char*>(script.c_str()), nullptr};
+        if(error == 0)
+            error = ::posix_spawnp(&_pid, "python3", &file_actions, nullptr, argv,
+                                   environ);
+
+        ::posix_spawn_file_actions_destroy(&file_actions);
+    }
+
+    if(error != 0)
+    {
+        ::close(command_pipe[0]);
+        ::close(command_pipe[1]);
+        ::close(reply_pipe[0]);
+        ::close(reply_pipe[1]);
+        throw std::runtime_error("Could not start a gym worker: " +
+                                 std::string(std::strerror(error)));
+    }
+
+    ::close(command_pipe[0]);
+    ::close(reply_pipe[1]);
+    _commands = command_pipe[1];
+    _replies = reply_pipe[0];
+
+    try
+    {
+        make_env(gym_env_id, kwargs);
+    } catch(...)
+    {
+        ::close(_commands);
+        ::close(_replies);
+        ::waitpid(_pid, nullptr, 0);
+        throw;
+    }
+
+    //A step is sent and replied to in one message each
+    _step_command.resize(2 + _action_size * sizeof(double));
+    _step_command[0] = 'T';
+    _step_reply.resize(_state_size * sizeof(double) + sizeof(double) + 1);
+
+}
+
+GymWorker::~GymWorker()
+{
+    //A worker that has already gone has nothing to close
+    try
+    {
+        const char close_command = 'C';
+        send(&close_command, 1);
+    } catch(const std::runtime_error&) {}
+
+    ::close(_commands);
+    ::close(_replies);
+    ::waitpid(_pid, nullptr, 0);
+}
+
+void GymWorker::make_env(const std::string& gym_env_id,
+                         const std::map<const std::string, const double>& kwargs)
+{
+    std::vector<char> message(1, 'M');
+    pack_string(message, gym_env_id);
+    pack(message, static_cast<uint32_t>(kwargs.size()));
+    for(const auto& kwarg : kwargs)
+    {
+        pack_string(message, kwarg.first);
+        pack(message, kwarg.second);
+    }
+    send(message.data(), message.size());
+
+    _state_size = receive<uint32_t>();
+
+    if(receive<uint8_t>())
+    {
+        _action_space_type = SpaceType::Discrete;
+        _action_space = std::make_unique<DiscreteSpace>(receive<uint32_t>());
+        _action_size = 1;
+    } else
+    {
+        _action_space_type = SpaceType::Box;
+
+        std::vector<unsigned> shape(receive<uint32_t>());
+        for(auto& dim : shape)
+            dim = receive<uint32_t>();
+
+        _action_size = 1;
+        for(const auto dim : shape)
+            _action_size *= dim;
+
+        std::vector<double> lows(_action_size);
+        std::vector<double> highs(_action_size);
+        receive(lows.data(), lows.size() * sizeof(double));
+        receive(highs.data(), highs.size() * sizeof(double));
+
+        _action_space = std::make_unique<BoxSpace>(shape, lows, highs);
+    }
+}
+
+unsigned GymWorker::get_state_size() const
+{
+    return _state_size;
+}
+
+SpaceType GymWorker::get_action_space_type() const
+{
+    return _action_space_type;
+}
+
+const Space& GymWorker::get_action_space() const
+{
+    return *_action_space;
+}
+
+void GymWorker::seed(const unsigned seed)
+{
+    std::vector<char> message(1, 'S');
+    pack(message, static_cast<uint32_t>(seed));
+    send(message.data(), message.size());
+}
+
+void GymWorker::reset(const unsigned seed, double* observation)
+{
+    std::vector<char> message(1, 'R');
+    pack(message, static_cast<uint32_t>(seed));
+    send(message.data(), message.size());
+    receive(observation, _state_size * sizeof(double));
+}
+
+double GymWorker::step(const double* action, const bool render, double* observation,
+                       bool& done)
+{
+    _step_command[1] = render;
+    std::memcpy(_step_command.data() + 2, action, _action_size * sizeof(double));
+    send(_step_command.data(), _step_command.size());
+
+    receive(_step_reply.data(), _step_reply.size());
+    std::memcpy(observation, _step_reply.data(), _state_size * sizeof(double));
+    double reward;
+    std::memcpy(&reward, _step_reply.data() + _state_size * sizeof(double),
+                sizeof(double));
+    done = _step_reply.back();
+
+    return reward;
+}
+
+void GymWorker::make_envs(const unsigned num_envs)
+{
+    std::vector<char> message(1, 'B');
+    pack(message, static_cast<uint32_t>(num_envs));
+    send(message.data(), message.size());
+
+    _num_envs = num_envs;
+}
+
+unsigned GymWorker::get_num_envs() const
+{
+    return _num_envs;
+}
+
+void GymWorker::reset_batch(const unsigned* seeds, const double* dones,
+                            double* observations)
+{
+    _batch_command.assign(1, 'Q');
+    for(unsigned i = 0; i < _num_envs; i++)
+        pack(_batch_command, static_cast<uint32_t>(seeds[i]));
+    const char* done_bytes = reinterpret_cast<const char*>(dones);
+    _batch_command.insert(_batch_command.end(), done_bytes,
+                          done_bytes + _num_envs * sizeof(double));
+    send(_batch_command.data(), _batch_command.size());
+
+    receive(observations, _num_envs * _state_size * sizeof(double));
+}
+
+void GymWorker::step_batch(const double* actions, const bool render,
+                           double* observations, double* rewards, double* dones)
+{
+    _batch_command.assign(1, 'V');
+    pack(_batch_command, static_cast<uint8_t>(render));
+    const char* done_bytes = reinterpret_cast<const char*>(dones);
+    _batch_command.insert(_batch_command.end(), done_bytes,
+                          done_bytes + _num_envs * sizeof(double));
+    const char* action_bytes = reinterpret_cast<const char*>(actions);
+    _batch_command.insert(_batch_command.end(), action_bytes,
+                          action_bytes + _num_envs * _action_size * sizeof(double));
+    send(_batch_command.data(), _batch_command.size());
+
+    receive(observations, _num_envs * _state_size * sizeof(double));
+    receive(rewards, _num_envs * sizeof(double));
+    receive(dones, _num_envs * sizeof(double));
+}
+
+void GymWorker::send(const void* data, const std::size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    std::size_t sent = 0;
+    while(sent < size)
+    {
+        const ssize_t n = ::write(_commands, bytes + sent, size - sent);
+        if(n == -1 && errno == EINTR)
+            continue;
+        if(n == -1 && errno == EPIPE)
+            throw std::runtime_error("Gym worker " + std::to_string(_pid) +
+                                     " has stopped, see its output on stderr");
+        if(n <= 0)
+            throw std::runtime_error("Could not send to gym worker " +
+                                     std::to_string(_pid) + ": " +
+                                     std::string(std::strerror(errno)));
+        sent += n;
+    }
+}
+
+void GymWorker::receive(void* data, const std::size_t size)
+{
+    char* bytes = static_cast<char*>(data);
+    std::size_t received = 0;
+    while(received < size)
+    {
+        const ssize_t n = ::read(_replies, bytes + received, size - received);
+        if(n == -1 && errno == EINTR)
+            continue;
+        if(n <= 0)
+            throw std::runtime_error("Gym worker " + std::to_string(_pid) +
+                                     " stopped replying, see its output on stderr");
+        received += n;
+    }
+}
+
+} // namespace NeuroEvo
@@ -1,172 +1,221 @@
 #include <domains/control_domains/maze/grid.h>
+#include <deque>
 #include <fstream>
 #include <sstream>
-#include <iterator>
-#include <iostream>
+#include <stdexcept>
 
 namespace NeuroEvo {
 
-Grid::Grid(const std::string file_name, const unsigned agent_start_x, 
-           const unsigned agent_start_y) :
-    _file_name(file_name) {
-
-    //Build grid from file
-    build_grid(_file_name);
-
-    _height = _squares.size();
-    _width = _squares.at(0).size();
-
-    _agent_x = agent_start_x;
-    _agent_y = agent_start_y;
-
+Grid::Grid(const std::string& file_name) :
+    _file_name(file_name)
+{
+    read_grid(file_name);
+    build_observations();
+    build_moves();
 }
 
-void Grid::build_grid(const std::string file_name) {
+void Grid::read_grid(const std::string& file_name)
+{
 
-    //Read grid from file
-    std::vector<std::vector<int> > square_types = read_grid(file_name, 1);
-    std::vector<std::vector<int> > square_rewards = read_grid(file_name, 2);
+    std::ifstream maze_file(file_name);
 
-    //Build grid squares
-    for(unsigned i = 0; i < square_types.size(); i++) {
+    if(!maze_file.is_open())
+        throw std::runtime_error("Could not open: " + file_name);
 
-        std::vector<GridSquare> square_row(square_types.at(i).size());
+    //Every block of lines between empty lines is a grid
+    std::vector<std::vector<std::vector<int>>> grids;
+    bool in_grid = false;
 
-        for(unsigned j = 0; j < square_types.at(i).size(); j++)
-            square_row.at(j) = GridSquare{j, i, 
-                                          square_types.at(i).at(j), 
-                                          square_rewards.at(i).at(j)};
+    std::string line;
+    while(std::getline(maze_file, line))
+    {
+        if(line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            in_grid = false;
+            continue;
+        }
 
-        _squares.push_back(square_row);
+        if(!in_grid)
+        {
+            grids.emplace_back();
+            in_grid = true;
+        }
 
-    }
+        std::istringstream iss(line);
+        std::vector<int> row;
+        int value;
+        while(iss >> value)
+            row.push_back(value);
 
-}
+        if(!iss.eof())
+            throw std::runtime_error("Could not read line \"" + line + "\" of " + file_name);
 
-std::vector<std::vector<int> > Grid::read_grid(const std::string file_name, 
-                                               const unsigned grid_num) {
+        grids.back().push_back(row);
+    }
 
-    std::vector<std::vector<int> > square_types;
+    if(grids.size() < 2)
+        throw std::runtime_error(file_name + " must hold a grid of square types and " +
+                                 "a grid of rewards");
 
-    //Open and read from .mz file
-    std::ifstream maze_file;
-    maze_file.open(file_name);
+    const std::vector<std::vector<int>>& square_types = grids[0];
+    const std::vector<std::vector<int>>& square_rewards = grids[1];
 
-    if(maze_file.is_open()) {
+    _height = square_types.size();
+    _width = square_types[0].size();
 
-        std::string line;
+    if(square_rewards.size() != _height)
+        throw std::runtime_error("The grids of " + file_name + " must be the same size");
 
-        //Get to the correct grid
-        unsigned num_empty_lines_found = 0;
-        while(num_empty_lines_found < grid_num) {
+    for(unsigned y = 0; y < _height; y++)
+        if(square_types[y].size() != _width || square_rewards[y].size() != _width)
+            throw std::runtime_error("Every row of the grids of " + file_name +
+                                     " must be the same length");
 
-            getline(maze_file, line);
-            if(line.empty())
-                num_empty_lines_found++;
+    _walls.resize(get_num_squares());
+    _rewards.resize(get_num_squares());
 
+    for(unsigned y = 0; y < _height; y++)
+        for(unsigned x = 0; x < _width; x++)
+        {
+            _walls[square(x, y)] = square_types[y][x] == 1;
+            _rewards[square(x, y)] = square_rewards[y][x];
         }
 
-        //Begin reading grid
-        while(getline(maze_file, line)) {
-
-            //Stop reading if line is empty
-            if(line.empty()) break;
+}
 
-            //Split line by white spaces
-            std::istringstream iss(line);
-            std::vector<std::string> split_string{std::istream_iterator<std::string>{iss},
-                                                  std::istream_iterator<std::string>{}};
+void Grid::build_observations()
+{
 
-            //Convert strings to ints
-            std::vector<int> square_types_row(split_string.size());
+    _observations.resize(get_num_squares() * OBSERVATION_SIZE);
 
-            for(std::size_t i = 0; i < split_string.size(); i++)
-                square_types_row.at(i) = std::stoi(split_string.at(i));
+    for(unsigned y = 0; y < _height; y++)
+        for(unsigned x = 0; x < _width; x++)
+        {
+            double* observation = _observations.data() + square(x, y) * OBSERVATION_SIZE;
 
-            square_types.push_back(square_types_row);
+            for(int dy = -1; dy <= 1; dy++)
+                for(int dx = -1; dx <= 1; dx++)
+                {
+                    const int nx = (int)x + dx;
+                    const int ny = (int)y + dy;
+                    const bool off_grid = nx < 0 || ny < 0 ||
+                                          nx >= (int)_width || ny >= (int)_height;
 
+                    *observation++ = (off_grid || is_wall(square(nx, ny))) ? 1. : 0.;
+                }
         }
 
-        maze_file.close();
-
-    } else {
-
-        std::cerr << "Could not open: " << file_name << std::endl;
-        exit(EXIT_FAILURE);
+}
 
-    }
+void Grid::build_moves()
+{
 
-    return square_types;
+    _moves.resize(get_num_squares() * NUM_ACTIONS);
 
-}
+    const int action_dx[NUM_ACTIONS] = {0, 0, -1, 1};
+    const int action_dy[NUM_ACTIONS] = {-1, 1, 0, 0};
 
-void Grid::move_agent(const unsigned x, const unsigned y) {
+    for(unsigned y = 0; y < _height; y++)
+        for(unsigned x = 0; x < _width; x++)
+            for(unsigned action = 0; action < NUM_ACTIONS; action++)
+            {
+                const int nx = (int)x + action_dx[action];
+                const int ny = (int)y + action_dy[action];
+                const bool blocked = nx < 0 || ny < 0 ||
+                                     nx >= (int)_width || ny >= (int)_height ||
+                                     is_wall(square(nx, ny));
 
-    _agent_x = x;
-    _agent_y = y;
+                _moves[square(x, y) * NUM_ACTIONS + action] =
+                    blocked ? square(x, y) : square(nx, ny);
+            }
 
 }
 
-void Grid::move_reward(const unsigned x, const unsigned y) {
+std::vector<unsigned> Grid::distance_field(const std::vector<int>& rewards) const
+{
 
-    //This function can be more generic in the future
+    std::vector<unsigned> distances(get_num_squares(), UNREACHABLE);
+    std::deque<unsigned> frontier;
 
-    //Remove previous reward
-    for(std::size_t i = 0; i < _squares.size(); i++)
-        for(std::size_t j = 0; j < _squares.at(i).size(); j++) {
-            if(_squares.at(i).at(j).reward != 0)
-                _squares.at(i).at(j).reward = 0;
+    for(unsigned i = 0; i < get_num_squares(); i++)
+        if(rewards[i] > 0)
+        {
+            distances[i] = 0;
+            frontier.push_back(i);
         }
 
-    //Add new reward
-    _squares.at(y).at(x).reward = 5;
-
-}
+    //Every move can be reversed, so the distance to a reward is the distance
+    //from it
+    while(!frontier.empty())
+    {
+        const unsigned current = frontier.front();
+        frontier.pop_front();
+
+        for(unsigned action = 0; action < NUM_ACTIONS; action++)
+        {
+            const unsigned next = get_move(current, action);
+            if(distances[next] == UNREACHABLE)
+            {
+                distances[next] = distances[current] + 1;
+                frontier.push_back(next);
+            }
+        }
+    }
 
-int Grid::get_square_type(const unsigned x, const unsigned y) {
-    return _squares.at(y).at(x).square_type;
-}
+    return distances;
 
-int Grid::get_reward(const unsigned x, const unsigned y) {
-    return _squares.at(y).at(x).reward;
 }
 
-void Grid::print_grid() {
-
-    for(std::size_t i = 0; i < _squares.size(); i++) {
-
-        for(std::size_t j = 0; j < _squares.at(i).size(); j++) {
-
-            char square_char;
-            int square_type = _squares.at(i).at(j).square_type;
-
-            switch(square_type) {
-
-                case 0:
-                    square_char = ' ';
-                    break;
-                case 1:
-                    square_char = 'H';
-                    break;
-
-            }
+void Grid::print(std::ostream& os, const unsigned agent_square,
+                 const std::vector<int>& rewards) const
+{
+
+    for(unsigned y = 0; y < _height; y++)
+    {
+        for(unsigned x = 0; x < _width; x++)
+        {
+            const unsigned i = square(x, y);
+
+            if(i == agent_square)
+                os << 'X';
+            else if(rewards[i] != 0)
+                os << 'O';
+            else if(is_wall(i))
+                os << 'H';
+            else
+                os << ' ';
+        }
 
-            if(_squares.at(i).at(j).reward != 0)
-                square_char = 'O';
+        os << std::endl;
+    }
 
-            if(_agent_x == j && _agent_y == i)
-                square_char = 'X';
+    os << std::endl;
 
-            std::cout << square_char;
+}
 
-        }
+unsigned Grid::get_width() const
+{
+    return _width;
+}
 
-        std::cout << std::endl;
+unsigned Grid::get_height() const
+{
+    return _height;
+}
 
-    }
+unsigned Grid::get_num_squares() const
+{
+    return _width * _height;
+}
 
-    std::cout << std::endl;
+const std::vector<int>& Grid::get_rewards() const
+{
+    return _rewards;
+}
 
+const std::string& Grid::get_file_name() const
+{
+    return _file_name;
 }
 
 } // namespace NeuroEvo
@@ -0,0 +1,198 @@
+#include <domains/dataset/dataset.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace NeuroEvo {
+
+namespace {
+
+const char file_magic[4] = {'N', 'E', 'D', 'S'};
+const uint32_t file_version = 1;
+
+struct FileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t num_inputs;
+    uint32_t num_targets;
+    uint64_t num_rows;
+};
+
+} // namespace
+
+Dataset::Dataset(const std::string& file_name) :
+    _mapping(nullptr),
+    _mapping_size(0)
+{
+    map_file(file_name);
+}
+
+Dataset::Dataset(const std::vector<std::vector<double>>& inputs,
+                 const std::vector<std::vector<double>>& targets) :
+    _mapping(nullptr),
+    _mapping_size(0)
+{
+    copy_rows(inputs, targets);
+}
+
+Dataset::Dataset(const JSON& json) :
+    _mapping(nullptr),
+    _mapping_size(0)
+{
+    if(json.has_value({"file"}))
+        map_file(json.get<std::string>({"file"}));
+    else
+        copy_rows(json.get<std::vector<std::vector<double>>>({"inputs"}),
+                  json.get<std::vector<std::vector<double>>>({"targets"}));
+}
+
+Dataset::~Dataset()
+{
+    if(_mapping)
+        ::munmap(_mapping, _mapping_size);
+}
+
+uint32_t Dataset::get_num_inputs() const
+{
+    return _num_inputs;
+}
+
+uint32_t Dataset::get_num_targets() const
+{
+    return _num_targets;
+}
+
+uint64_t Dataset::get_num_rows() const
+{
+    return _num_rows;
+}
+
+Dataset::Columns Dataset::get_inputs() const
+{
+    return Columns(_data, _num_inputs, _num_rows,
+                   Eigen::OuterStride<>(_num_inputs + _num_targets));
+}
+
+Dataset::Columns Dataset::get_targets() const
+{
+    return Columns(_data + _num_inputs, _num_targets, _num_rows,
+                   Eigen::OuterStride<>(_num_inputs + _num_targets));
+}
+
+JSON Dataset::to_json() const
+{
+    JSON json;
+    if(!_file_name.empty())
+    {
+        json.emplace("file", _file_name);
+        return json;
+    }
+
+    std::vector<std::vector<double>> inputs(_num_rows);
+    std::vector<std::vector<double>> targets(_num_rows);
+    for(uint64_t i = 0; i < _num_rows; i++)
+    {
+        const double* row = _data + i * (_num_inputs + _num_targets);
+        inputs[i].assign(row, row + _num_inputs);
+        targets[i].assign(row + _num_inputs, row + _num_inputs + _num_targets);
+    }
+    json.emplace("inputs", inputs);
+    json.emplace("targets", targets);
+    return json;
+}
+
+void Dataset::map_file(const std::string& file_name)
+{
+    _file_name = file_name;
+
+    const int fd = ::open(file_name.c_str(), O_RDONLY);
+    if(fd == -1)
+        throw std::runtime_error("Could not open dataset " + file_name + ": " +
+                                 std::strerror(errno));
+
+    struct stat file_stat;
+    if(::fstat(fd, &file_stat) == -1)
+    {
+        ::close(fd);
+        throw std::runtime_error("Could not read dataset " + file_name + ": " +
+                                 std::strerror(errno));
+    }
+    _mapping_size = file_stat.st_size;
+
+    FileHeader header;
+    if(_mapping_size < sizeof(FileHeader) ||
+       ::pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+       std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0 ||
+       header.version != file_version)
+    {
+        ::close(fd);
+        throw std::runtime_error(file_name + " is not a version " +
+                                 std::to_string(file_version) + " dataset file");
+    }
+
+    _num_inputs = header.num_inputs;
+    _num_targets = header.num_targets;
+    _num_rows = header.num_rows;
+
+    //Losses are averaged over the rows
+    if(_num_rows == 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Dataset " + file_name + " has no rows");
+    }
+
+    const std::size_t data_size =
+        _num_rows * (_num_inputs + _num_targets) * sizeof(double);
+    if(_mapping_size != sizeof(FileHeader) + data_size)
+    {
+        ::close(fd);
+        throw std::runtime_error("The size of dataset " + file_name +
+                                 " does not match its header");
+    }
+
+    _mapping = ::mmap(nullptr, _mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(_mapping == MAP_FAILED)
+    {
+        _mapping = nullptr;
+        throw std::runtime_error("Could not map dataset " + file_name + ": " +
+                                 std::strerror(errno));
+    }
+    //Every row is read on every evaluation
+    ::madvise(_mapping, _mapping_size, MADV_WILLNEED);
+
+    _data = reinterpret_cast<const double*>(
+        static_cast<const char*>(_mapping) + sizeof(FileHeader)
+    );
+}
+
+void Dataset::copy_rows(const std::vector<std::vector<double>>& inputs,
+                        const std::vector<std::vector<double>>& targets)
+{
+    if(inputs.empty() || inputs.size() != targets.size())
+        throw std::invalid_argument("A dataset needs the same number of inputs "
+                                    "and targets, and at least one row");
+
+    _num_inputs = inputs.front().size();
+    _num_targets = targets.front().size();
+    _num_rows = inputs.size();
+
+    _rows.reserve(_num_rows * (_num_inputs + _num_targets));
+    for(uint64_t i = 0; i < _num_rows; i++)
+    {
+        if(inputs[i].size() != _num_inputs || targets[i].size() != _num_targets)
+            throw std::invalid_argument("Every row of a dataset must have the same "
+                                        "number of inputs and targets");
+        _rows.insert(_rows.end(), inputs[i].begin(), inputs[i].end());
+        _rows.insert(_rows.end(), targets[i].begin(), targets[i].end());
+    }
+
+    _data = _rows.data();
+}
+
+} // namespace NeuroEvo
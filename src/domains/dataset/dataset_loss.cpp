@@ -0,0 +1,64 @@
+#include <domains/dataset/dataset_loss.h>
+
+namespace NeuroEvo {
+
+double AbsErrorLoss::score(const Eigen::Ref<const Eigen::MatrixXd>& outputs,
+                           const Eigen::Ref<const Eigen::MatrixXd>& targets) const
+{
+    return -(outputs - targets).cwiseAbs().sum() / outputs.rows();
+}
+
+JSON AbsErrorLoss::to_json() const
+{
+    JSON json;
+    json.emplace("name", "AbsErrorLoss");
+    return json;
+}
+
+double MSELoss::score(const Eigen::Ref<const Eigen::MatrixXd>& outputs,
+                      const Eigen::Ref<const Eigen::MatrixXd>& targets) const
+{
+    return -(outputs - targets).squaredNorm() / outputs.rows();
+}
+
+JSON MSELoss::to_json() const
+{
+    JSON json;
+    json.emplace("name", "MSELoss");
+    return json;
+}
+
+AccuracyLoss::AccuracyLoss(const double threshold) :
+    _threshold(threshold) {}
+
+AccuracyLoss::AccuracyLoss(const JSON& json) :
+    _threshold(json.value({"threshold"}, 0.5)) {}
+
+double AccuracyLoss::score(const Eigen::Ref<const Eigen::MatrixXd>& outputs,
+                           const Eigen::Ref<const Eigen::MatrixXd>& targets) const
+{
+    if(outputs.rows() == 1)
+        return ((outputs.array() >= _threshold) == (targets.array() >= _threshold))
+            .count();
+
+    double num_correct = 0.;
+    for(Eigen::Index i = 0; i < outputs.cols(); i++)
+    {
+        Eigen::Index output_class, target_class;
+        outputs.col(i).maxCoeff(&output_class);
+        targets.col(i).maxCoeff(&target_class);
+        if(output_class == target_class)
+            num_correct += 1.;
+    }
+    return num_correct;
+}
+
+JSON AccuracyLoss::to_json() const
+{
+    JSON json;
+    json.emplace("name", "AccuracyLoss");
+    json.emplace("threshold", _threshold);
+    return json;
+}
+
+} // namespace NeuroEvo
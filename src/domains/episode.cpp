@@ -0,0 +1,62 @@
+#include <domains/episode.h>
+#include <utility>
+
+namespace NeuroEvo {
+
+Episode::Episode(const std::coroutine_handle<promise_type> handle) :
+    _handle(handle) {}
+
+Episode::Episode(Episode&& episode) noexcept :
+    _handle(std::exchange(episode._handle, nullptr)) {}
+
+Episode& Episode::operator=(Episode&& episode) noexcept
+{
+    if(this != &episode)
+    {
+        if(_handle)
+            _handle.destroy();
+        _handle = std::exchange(episode._handle, nullptr);
+    }
+    return *this;
+}
+
+Episode::~Episode()
+{
+    if(_handle)
+        _handle.destroy();
+}
+
+void Episode::start()
+{
+    resume();
+}
+
+void Episode::step(const std::vector<double>& outputs)
+{
+    _handle.promise()._outputs = &outputs;
+    resume();
+}
+
+bool Episode::done() const
+{
+    return _handle.done();
+}
+
+const std::vector<double>& Episode::get_observation() const
+{
+    return *_handle.promise()._observation;
+}
+
+double Episode::get_fitness() const
+{
+    return _handle.promise()._fitness;
+}
+
+void Episode::resume()
+{
+    _handle.resume();
+    if(_handle.promise()._exception)
+        std::rethrow_exception(_handle.promise()._exception);
+}
+
+} // namespace NeuroEvo
@@ -1,16 +1,68 @@
 #include <genetic_operators/mutation/bit_flip_mutator.h>
+#include <algorithm>
+#include <bit>
 
 namespace NeuroEvo {
 
-BitFlipMutator::BitFlipMutator(const double mutation_rate) :
-    Mutator(mutation_rate) {}
+BitFlipMutator::BitFlipMutator(const double mutation_rate, const bool skip_sampling) :
+    Mutator(mutation_rate, skip_sampling),
+    _fixed_point_rate(static_cast<std::uint64_t>(
+        std::llround(std::clamp(mutation_rate, 0., 1.) * 0x1.0p32))),
+    _mask_rounds(0),
+    _mask_rng(CounterRNG::random_seed())
+{
+    //Bits of the rate below the lowest set bit do not need a round
+    if(_fixed_point_rate != 0)
+        _mask_rounds = 32 - std::countr_zero(_fixed_point_rate);
+}
+
+void BitFlipMutator::mutate(BitVector& genes) {
+
+    //Skip sampling costs a uniform draw and a log per mutated bit, roughly that
+    //of four random words, whereas masks cost a fixed number of words per 64 bits
+    if(_skip_sampling &&
+       4. * _mutation_rate * BitVector::BITS_PER_WORD < static_cast<double>(_mask_rounds))
+    {
+        for_each_mutated_gene(
+            genes.size(),
+            [&genes](const std::size_t i) {genes.flip(i);}
+        );
+        return;
+    }
+
+    for(auto& word : genes.words_mut())
+        word ^= random_mask();
+    genes.clear_padding();
 
-void BitFlipMutator::mutate(std::vector<bool>& genes) {
+}
+
+BitVector::word_type BitFlipMutator::random_mask()
+{
+    //A rate of 1 does not fit in 32 bits
+    if(_fixed_point_rate >> 32)
+        return ~BitVector::word_type(0);
 
-    for(std::size_t i = 0; i < genes.size(); i++)
-        if(should_mutate())
-            genes[i] = !genes[i];
+    //Working from the least significant bit of the rate, ORing with a random
+    //word maps a bit probability q to (1 + q) / 2 and ANDing maps it to q / 2
+    BitVector::word_type mask = 0;
+    for(unsigned i = 32 - _mask_rounds; i < 32; i++)
+    {
+        if((_fixed_point_rate >> i) & 1)
+            mask |= random_word();
+        else
+            mask &= random_word();
+    }
+
+    return mask;
+}
 
+void BitFlipMutator::reset_mutator(const std::optional<unsigned>& seed)
+{
+    //A separate stream to the one used for skip sampling
+    if(seed.has_value())
+        _mask_rng.seed(seed.value(), 1);
+    else
+        _mask_rng.seed(CounterRNG::random_seed());
 }
 
 } // namespace NeuroEvo
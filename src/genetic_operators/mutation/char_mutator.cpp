@@ -3,24 +3,33 @@
 namespace NeuroEvo {
 
 CharMutator::CharMutator(const double mutation_rate, const std::set<char>& char_set,
-                         const std::optional<std::vector<double>>& char_distr) :
-    Mutator(mutation_rate),
+                         const std::optional<std::vector<double>>& char_distr,
+                         const bool skip_sampling) :
+    Mutator(mutation_rate, skip_sampling),
     _char_distr(char_set, char_distr) {}
 
 void CharMutator::mutate(std::vector<char>& genes)
 {
 
-    for(auto& gene : genes)
-    {
-        if(!should_mutate())
-            continue;
+    for_each_mutated_gene(
+        genes.size(),
+        [this, &genes](const std::size_t i)
+        {
+            char new_gene = genes[i];
+            while(new_gene == genes[i])
+                new_gene = _char_distr.next();
+            genes[i] = new_gene;
+        }
+    );
 
-        char new_gene = gene;
-        while(new_gene == gene)
-            new_gene = _char_distr.next();
-
-    }
+}
 
+void CharMutator::reset_mutator(const std::optional<unsigned>& seed)
+{
+    if(seed.has_value())
+        _char_distr.set_seed(seed.value());
+    else
+        _char_distr.randomly_seed();
 }
 
 } // namespace NeuroEvo
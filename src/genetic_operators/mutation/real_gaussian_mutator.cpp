@@ -1,5 +1,7 @@
 #include <genetic_operators/mutation/real_gaussian_mutator.h>
 #include <stdexcept>
+#include <algorithm>
+#include <limits>
 
 namespace NeuroEvo {
 
@@ -7,8 +9,9 @@ RealGaussianMutator::RealGaussianMutator(
     const double mutation_rate,
     const double mutation_power,
     const std::optional<const double> lower_bound,
-    const std::optional<const double> upper_bound) :
-    Mutator(mutation_rate),
+    const std::optional<const double> upper_bound,
+    const bool skip_sampling) :
+    Mutator(mutation_rate, skip_sampling),
     _mut_power_distr(0, mutation_power),
     _lower_bound(lower_bound),
     _upper_bound(upper_bound),
@@ -20,8 +23,9 @@ RealGaussianMutator::RealGaussianMutator(
     const double mutation_rate,
     const double mutation_power,
     const std::vector<double>& lower_bounds,
-    const std::vector<double>& upper_bounds) :
-    Mutator(mutation_rate),
+    const std::vector<double>& upper_bounds,
+    const bool skip_sampling) :
+    Mutator(mutation_rate, skip_sampling),
     _mut_power_distr(0, mutation_power),
     _lower_bound(std::nullopt),
     _upper_bound(std::nullopt),
@@ -37,53 +41,64 @@ RealGaussianMutator::RealGaussianMutator(
 RealGaussianMutator::RealGaussianMutator(const JSON& json) :
     RealGaussianMutator(
         json.at({"mutation_rate"}),
-        json.at({"mutation_power"})
+        json.at({"mutation_power"}),
+        std::nullopt,
+        std::nullopt,
+        json.value({"skip_sampling"}, true)
     ) {}
 
 void RealGaussianMutator::mutate(std::vector<double>& genes)
 {
 
-    for(std::size_t i = 0; i < genes.size(); i++)
-    {
-        if(!should_mutate())
-            continue;
+    //Check for bounds size and compare to genes size
+    //I do not need to check size for upper bounds too because it has
+    //already been checked in the constructor that both bounds are the same
+    //size
+    if(_lower_bounds.has_value() && _lower_bounds->size() != genes.size())
+        throw std::length_error("Genes size and lower bounds size mismatch"
+            " in RealGaussianMutator::mutate\nLower bounds size: "
+            + std::to_string(_lower_bounds->size()) + " Genes size: "
+            + std::to_string(genes.size()));
+
+    //Add value from gaussian distribution
+    _mutated_genes.clear();
+    for_each_mutated_gene(
+        genes.size(),
+        [this, &genes](const std::size_t i)
+        {
+            genes[i] += _mut_power_distr.next();
+            _mutated_genes.push_back(i);
+        }
+    );
 
-        //Add value from gaussian distribution
-        double new_gene = genes[i] + _mut_power_distr.next();
+    clamp_mutated_genes(genes);
 
-        //Check for lower bounds
-        if(_lower_bound.has_value())
-            if(new_gene < _lower_bound.value())
-                new_gene = _lower_bound.value();
+}
 
-        if(_lower_bounds.has_value())
-        {
-            //Check for lower bounds size and compare to genes size
-            //I do not need to check size for upper bounds too because it has
-            //already been checked in the constructor that both bounds are the same
-            //size
-            if(_lower_bounds->size() != genes.size())
-                throw std::length_error("Genes size and lower bounds size mismatch"
-                    " in RealGaussianMutator::mutate\nLower bounds size: "
-                    + std::to_string(_lower_bounds->size()) + " Genes size: "
-                    + std::to_string(genes.size()));
-
-            if(new_gene < _lower_bounds.value()[i])
-                new_gene = _lower_bounds.value()[i];
+//Genes that were not mutated are left alone, even if they are out of bounds
+void RealGaussianMutator::clamp_mutated_genes(std::vector<double>& genes) const
+{
 
-        }
+    if(_lower_bound.has_value() || _upper_bound.has_value())
+    {
+        const double lower = _lower_bound.value_or(
+            -std::numeric_limits<double>::infinity());
+        const double upper = _upper_bound.value_or(
+            std::numeric_limits<double>::infinity());
 
-        //Check for upper bounds
-        if(_upper_bound.has_value())
-            if(new_gene > _upper_bound.value())
-                new_gene = _upper_bound.value();
+        for(const auto i : _mutated_genes)
+            genes[i] = std::min(std::max(genes[i], lower), upper);
+    }
 
-        if(_upper_bounds.has_value())
-            if(new_gene > _upper_bounds.value()[i])
-                new_gene = _upper_bounds.value()[i];
+    if(_lower_bounds.has_value())
+    {
+        const std::vector<double>& lower = _lower_bounds.value();
+        const std::vector<double>& upper = _upper_bounds.value();
 
-        genes[i] = new_gene;
+        for(const auto i : _mutated_genes)
+            genes[i] = std::min(std::max(genes[i], lower[i]), upper[i]);
     }
+
 }
 
 void RealGaussianMutator::reset_mutator(const std::optional<unsigned>& seed)
@@ -14,7 +14,7 @@ DCTMap::DCTMap(const unsigned c, const unsigned num_neurons,
     _num_neurons(num_neurons),
     _inputs_per_neuron(inputs_per_neuron) {}
 
-Phenotype<double>* DCTMap::map(Genotype<double>& genotype)
+Phenotype<double>* DCTMap::map(const Genotype<double>& genotype) const
 {
     // Assume genes are the DCT coefficients
     Matrix<double> coefficients(_num_neurons, _inputs_per_neuron, genotype.genes());
@@ -34,7 +34,7 @@ Phenotype<double>* DCTMap::map(Genotype<double>& genotype)
 
 }
 
-void DCTMap::remove_higher_frequencies(Matrix<double>& coefficients)
+void DCTMap::remove_higher_frequencies(Matrix<double>& coefficients) const
 {
 
     const unsigned& height = coefficients.get_height();
@@ -31,7 +31,7 @@ MatrixMap::MatrixMap(const std::string& file_name,
     GPMap<double, double>(pheno_spec),
     _interaction_matrix(read_matrix(file_name)) {}
 
-Phenotype<double>* MatrixMap::map(Genotype<double>& genotype)
+Phenotype<double>* MatrixMap::map(const Genotype<double>& genotype) const
 {
 
     const Matrix<double> genes(genotype.genes());
@@ -7,12 +7,23 @@ BoolToBoolNetMap::BoolToBoolNetMap(NetworkBuilder& net_builder,
                                    std::shared_ptr<VectorPhenotypeSpec> pheno_spec) :
     NetworkMap<bool, bool>(net_builder, pheno_spec) {}
 
-Phenotype<bool>* BoolToBoolNetMap::map(Genotype<bool>& genotype)
+Phenotype<bool>* BoolToBoolNetMap::map(const Genotype<bool>& genotype) const
 {
+    //Unpack the genotype a word at a time
+    const BitVector& genes = genotype.genes();
+    std::vector<double> double_genotype(genes.size());
+    for(std::size_t w = 0; w < genes.words().size(); w++)
+    {
+        const BitVector::word_type word = genes.words()[w];
+        const std::size_t first_gene = w * BitVector::BITS_PER_WORD;
+        const std::size_t last_gene = std::min(first_gene + BitVector::BITS_PER_WORD,
+                                               genes.size());
+        for(std::size_t i = first_gene; i < last_gene; i++)
+            double_genotype[i] = static_cast<double>((word >> (i - first_gene)) & 1);
+    }
+
     //Push genotype through decoder
-    const std::vector<double> double_genotype(genotype.genes().begin(),
-                                              genotype.genes().end());
-    const std::vector<double> decoder_output = _decoder->activate(double_genotype);
+    const std::vector<double> decoder_output = decode(double_genotype);
 
     //Cast output back to bools
     std::vector<bool> traits(decoder_output.size());
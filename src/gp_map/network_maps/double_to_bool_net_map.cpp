@@ -7,10 +7,10 @@ DoubleToBoolNetMap::DoubleToBoolNetMap(NetworkBuilder& net_builder,
                                        std::shared_ptr<VectorPhenotypeSpec> pheno_spec) :
     NetworkMap<double, bool>(net_builder, pheno_spec) {}
 
-Phenotype<bool>* DoubleToBoolNetMap::map(Genotype<double>& genotype)
+Phenotype<bool>* DoubleToBoolNetMap::map(const Genotype<double>& genotype) const
 {
     //Push genotype through decoder
-    const std::vector<double> decoder_output = _decoder->activate(genotype.genes());
+    const std::vector<double> decoder_output = decode(genotype.genes());
 
     //Cast output back to bools
     std::vector<bool> traits(decoder_output.size());
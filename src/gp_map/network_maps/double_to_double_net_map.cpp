@@ -11,10 +11,10 @@ DoubleToDoubleNetMap::DoubleToDoubleNetMap(
 DoubleToDoubleNetMap::DoubleToDoubleNetMap(const JSON& json) :
     NetworkMap<double, double>(json) {}
 
-Phenotype<double>* DoubleToDoubleNetMap::map(Genotype<double>& genotype)
+Phenotype<double>* DoubleToDoubleNetMap::map(const Genotype<double>& genotype) const
 {
     //Push genotype through decoder
-    const std::vector<double> decoder_output = _decoder->activate(genotype.genes());
+    const std::vector<double> decoder_output = decode(genotype.genes());
 
     //The output of the decoder are the traits of the returned vector
     return new VectorPhenotype<double>(decoder_output);
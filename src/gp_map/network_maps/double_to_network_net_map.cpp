@@ -7,16 +7,15 @@ DoubleToNetworkNetMap::DoubleToNetworkNetMap(NetworkBuilder& decoder_spec,
                                              std::shared_ptr<NetworkBuilder> pheno_spec) :
     NetworkMap<double, double>(decoder_spec, pheno_spec) {}
 
-Phenotype<double>* DoubleToNetworkNetMap::map(Genotype<double>& genotype)
+Phenotype<double>* DoubleToNetworkNetMap::map(const Genotype<double>& genotype) const
 {
     //Push genotype through the decoder
-    const std::vector<double> decoder_output = _decoder->activate(genotype.genes());
+    const std::vector<double> decoder_output = decode(genotype.genes());
 
-    //Set network weights to decoder output
-    NetworkBuilder* pheno_net_builder = dynamic_cast<NetworkBuilder*>(_pheno_spec.get());
-    pheno_net_builder->set_init_weights(decoder_output);
-    auto pheno = pheno_net_builder->build_network();
-    return pheno;
+    //Build the network with the decoder output as its weights
+    const NetworkBuilder* pheno_net_builder =
+        dynamic_cast<const NetworkBuilder*>(_pheno_spec.get());
+    return pheno_net_builder->build_network(decoder_output);
 }
 
 JSON DoubleToNetworkNetMap::to_json_impl() const
@@ -8,7 +8,7 @@ DoubleToBoolVectorMap::DoubleToBoolVectorMap(
     GPMap<double, bool>(pheno_spec) {}
 
 //If the gene value is less than 0.5 then the trait is false and vice versa
-Phenotype<bool>* DoubleToBoolVectorMap::map(Genotype<double>& genotype)
+Phenotype<bool>* DoubleToBoolVectorMap::map(const Genotype<double>& genotype) const
 {
     std::vector<bool> traits(genotype.genes().size());
 
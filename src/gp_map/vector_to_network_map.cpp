@@ -10,9 +10,10 @@ VectorToNetworkMap::VectorToNetworkMap(const JSON& json) :
         std::make_shared<NetworkBuilder>(JSON(json.at({"PhenotypeSpec"})))
     ) {}
 
-Phenotype<double>* VectorToNetworkMap::map(Genotype<double>& genotype)
+Phenotype<double>* VectorToNetworkMap::map(const Genotype<double>& genotype) const
 {
-    NetworkBuilder* net_builder_cast = dynamic_cast<NetworkBuilder*>(_pheno_spec.get());
+    const NetworkBuilder* net_builder_cast =
+        dynamic_cast<const NetworkBuilder*>(_pheno_spec.get());
 
     if(net_builder_cast == nullptr)
     {
@@ -21,10 +22,8 @@ Phenotype<double>* VectorToNetworkMap::map(Genotype<double>& genotype)
         exit(0);
     }
 
-    //Set network weights as the genes
-    net_builder_cast->set_init_weights(genotype.genes());
-    auto network = net_builder_cast->build_network();
-    return network;
+    //Build the network with the genes as its weights
+    return net_builder_cast->build_network(genotype.genes());
 }
 
 JSON VectorToNetworkMap::to_json_impl() const
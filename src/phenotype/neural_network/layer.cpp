@@ -25,7 +25,9 @@ Layer::Layer(const Layer& layer) :
     _activation_function(layer._activation_function ?
                          layer._activation_function->clone() : nullptr),
     _bias(layer._bias),
-    _neurons(layer._num_neurons)
+    _neurons(layer._num_neurons),
+    _weight_matrix(layer._weight_matrix),
+    _biases(layer._biases)
 {
     for(std::size_t i = 0; i < _neurons.size(); i++)
         _neurons[i] = layer._neurons[i]->clone();
@@ -66,6 +68,21 @@ void Layer::set_weights(const std::vector<double>& weights)
 
     }
 
+    if(!batchable())
+        return;
+
+    _weight_matrix.resize(_num_neurons, _inputs_per_neuron);
+    _biases = Eigen::VectorXd::Zero(_num_neurons);
+
+    for(std::size_t i = 0; i < _neurons.size(); i++)
+    {
+        const std::vector<double>& neuron_weights = _neurons[i]->get_weights();
+        for(unsigned j = 0; j < _inputs_per_neuron; j++)
+            _weight_matrix(i, j) = neuron_weights[j];
+        if(_bias)
+            _biases(i) = neuron_weights[_inputs_per_neuron];
+    }
+
 }
 
 void Layer::set_trace(const bool trace)
@@ -80,6 +97,11 @@ unsigned Layer::get_number_of_weights() const
     return _num_neurons * _params_per_neuron;
 }
 
+unsigned Layer::get_num_neurons() const
+{
+    return _num_neurons;
+}
+
 std::vector<double> Layer::get_weights() const
 {
     std::vector<double> weights;
@@ -98,14 +120,20 @@ std::shared_ptr<ActivationFunction> Layer::get_activation_function() const
 
 std::vector<double> Layer::evaluate(const std::vector<double>& inputs)
 {
-
     std::vector<double> outputs;
-    outputs.reserve(_neurons.size());
+    evaluate_into(inputs, outputs);
+    return outputs;
+}
+
+void Layer::evaluate_into(const std::vector<double>& inputs, std::vector<double>& outputs)
+{
+
+    outputs.resize(_neurons.size());
 
     for(std::size_t i = 0; i < _neurons.size(); i++)
     {
         if(_trace) std::cout << "Neuron: " << i << std::endl;
-        outputs.push_back(_neurons[i]->evaluate(inputs));
+        outputs[i] = _neurons[i]->evaluate(inputs);
     }
 
     //Print outputs
@@ -114,7 +142,25 @@ std::vector<double> Layer::evaluate(const std::vector<double>& inputs)
         print_outputs(outputs);
     }
 
-    return outputs;
+}
+
+bool Layer::batchable() const
+{
+    return _neuron_type == NeuronType::Standard;
+}
+
+void Layer::evaluate_batch(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                           Eigen::Ref<Eigen::MatrixXd> outputs) const
+{
+
+    outputs.noalias() = _weight_matrix * inputs;
+    outputs.colwise() += _biases;
+
+    //Apply activation function if there is one there
+    if(_activation_function)
+        outputs = outputs.unaryExpr(
+            [this](const double x) { return _activation_function->activate(x); }
+        );
 
 }
 
@@ -1,4 +1,5 @@
 #include <phenotype/neural_network/network.h>
+#include <algorithm>
 #include <fstream>
 
 namespace NeuroEvo {
@@ -62,6 +63,75 @@ std::vector<double> Network::activate(const std::vector<double>& inputs)
     return propogate(inputs);
 }
 
+void Network::activate_into(const std::vector<double>& inputs, std::vector<double>& outputs)
+{
+    propogate_into(inputs, outputs);
+}
+
+bool Network::batchable() const
+{
+    //Tracing prints every neuron as it is activated
+    if(_trace)
+        return false;
+
+    return std::all_of(_layers.begin(), _layers.end(),
+                       [](const std::unique_ptr<Layer>& layer)
+                       {
+                           return layer->batchable();
+                       });
+}
+
+void Network::activate_batch(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                             Eigen::MatrixXd& outputs)
+{
+    activate_batch({this}, {inputs.cols()}, inputs, outputs);
+}
+
+void Network::activate_batch(const std::vector<Network*>& networks,
+                             const std::vector<Eigen::Index>& num_columns,
+                             const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                             Eigen::MatrixXd& outputs)
+{
+    std::array<Eigen::MatrixXd, 2>& hidden_outputs =
+        networks.front()->_hidden_batch_outputs;
+    const std::size_t num_layers = networks.front()->_layers.size();
+
+    const auto evaluate_layer = [&](const std::size_t layer,
+                                    const Eigen::Ref<const Eigen::MatrixXd>& ins,
+                                    Eigen::MatrixXd& outs)
+    {
+        outs.resize(networks.front()->_layers[layer]->get_num_neurons(), ins.cols());
+
+        Eigen::Index first = 0;
+        for(std::size_t j = 0; j < networks.size(); j++)
+        {
+            networks[j]->_layers[layer]->evaluate_batch(
+                ins.middleCols(first, num_columns[j]),
+                outs.middleCols(first, num_columns[j]));
+            first += num_columns[j];
+        }
+    };
+
+    for(std::size_t i = 0; i < num_layers; i++)
+    {
+        Eigen::MatrixXd& outs = (i + 1 == num_layers) ? outputs : hidden_outputs[i % 2];
+        if(i == 0)
+            evaluate_layer(i, inputs, outs);
+        else
+            evaluate_layer(i, hidden_outputs[(i - 1) % 2], outs);
+    }
+}
+
+bool Network::same_shape(const Network& network) const
+{
+    return std::equal(_layers.begin(), _layers.end(),
+                      network._layers.begin(), network._layers.end(),
+                      [](const std::unique_ptr<Layer>& a, const std::unique_ptr<Layer>& b)
+                      {
+                          return a->get_num_neurons() == b->get_num_neurons();
+                      });
+}
+
 void Network::reset()
 {
     for(auto& layer : _layers)
@@ -99,15 +169,24 @@ const std::vector<std::unique_ptr<Layer>>& Network::get_layers() const
 
 std::vector<double> Network::propogate(const std::vector<double>& inputs)
 {
-    std::vector<double> ins = inputs;
+    std::vector<double> outputs;
+    propogate_into(inputs, outputs);
+    return outputs;
+}
+
+void Network::propogate_into(const std::vector<double>& inputs, std::vector<double>& outputs)
+{
+    const std::vector<double>* ins = &inputs;
 
     for(std::size_t i = 0; i < _layers.size(); i++)
     {
         if(_trace) std::cout << "\nLayer: " << i << std::endl;
-        ins = _layers[i]->evaluate(ins);
-    }
 
-    return ins;
+        std::vector<double>& outs = (i + 1 == _layers.size()) ? outputs :
+                                    _hidden_outputs[i % 2];
+        _layers[i]->evaluate_into(*ins, outs);
+        ins = &outs;
+    }
 }
 
 JSON Network::to_json_impl() const
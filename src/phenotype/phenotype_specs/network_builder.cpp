@@ -96,25 +96,43 @@ Phenotype<double>* NetworkBuilder::build_network()
     if(_init_weight_distr)
         _init_weights = generate_init_weights();
 
+    return create_network(_init_weights ? &_init_weights.value() : nullptr);
+
+}
+
+Phenotype<double>* NetworkBuilder::build_network(
+    const std::vector<double>& weights) const
+{
+    return create_network(&weights);
+}
+
+Phenotype<double>* NetworkBuilder::create_network(
+    const std::vector<double>* init_weights) const
+{
+
     //Check init weights size if needed
-    if(_init_weights.has_value())
-        if(_init_weights->size() != get_num_params())
+    if(init_weights != nullptr)
+        if(init_weights->size() != get_num_params())
             throw std::length_error(
                 "The number of genes given to build the network was not equal"
                 " to the number of params required by the network\n"
-                "Num genes: " + std::to_string(_init_weights->size()) +
+                "Num genes: " + std::to_string(init_weights->size()) +
                 "\nNum params required: " + std::to_string(get_num_params()));
 
     //Check for Hebbian
     if(_hebbs_spec)
     {
 
+        if(init_weights == nullptr)
+            throw std::invalid_argument("A Hebbian network cannot be built without "
+                                        "weights");
+
         HebbsNetwork* network = new HebbsNetwork(*_hebbs_spec, _trace);
         network->create_net(_layer_specs);
 
         //Split weights for Hebbs network into weights and learning rates
         const std::pair<std::vector<double>, std::vector<double>> split_weights =
-            split_hebbs_traits(_init_weights.value());
+            split_hebbs_traits(*init_weights);
         network->propogate_weights(split_weights.first);
         network->propogate_learning_rates(split_weights.second);
 
@@ -130,9 +148,13 @@ Phenotype<double>* NetworkBuilder::build_network()
         if(_read_file_path)
             torch_network = new TorchNetwork(_read_file_path.value(),
                                              _trace);
+        else if(init_weights != nullptr)
+            torch_network = new TorchNetwork(_layer_specs,
+                                             *init_weights,
+                                             _trace);
         else
             torch_network = new TorchNetwork(_layer_specs,
-                                             _init_weights,
+                                             std::nullopt,
                                              _trace);
 
         return torch_network;
@@ -144,8 +166,8 @@ Phenotype<double>* NetworkBuilder::build_network()
         Network* network = new Network(_trace);
         network->create_net(_layer_specs);
 
-        if(_init_weights)
-            network->propogate_weights(_init_weights.value());
+        if(init_weights != nullptr)
+            network->propogate_weights(*init_weights);
 
         return network;
     }
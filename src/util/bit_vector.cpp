@@ -0,0 +1,84 @@
+#include <util/bit_vector.h>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace NeuroEvo {
+
+BitVector::BitVector(const std::size_t size, const bool value) :
+    _size(size),
+    _words((size + BITS_PER_WORD - 1) / BITS_PER_WORD,
+           value ? ~word_type(0) : word_type(0))
+{
+    clear_padding();
+}
+
+BitVector::BitVector(const std::vector<bool>& bits) :
+    _size(0)
+{
+    assign(bits);
+}
+
+bool BitVector::at(const std::size_t i) const
+{
+    if(i >= _size)
+        throw std::out_of_range("BitVector index " + std::to_string(i) +
+                                " is out of range for size " + std::to_string(_size));
+    return (*this)[i];
+}
+
+std::size_t BitVector::count() const
+{
+    std::size_t num_set = 0;
+    for(const auto word : _words)
+        num_set += std::popcount(word);
+    return num_set;
+}
+
+std::size_t BitVector::find_first() const
+{
+    for(std::size_t i = 0; i < _words.size(); i++)
+        if(_words[i] != 0)
+            return i * BITS_PER_WORD + std::countr_zero(_words[i]);
+    return _size;
+}
+
+std::size_t BitVector::hamming_distance(const BitVector& other) const
+{
+    if(other._size != _size)
+        throw std::length_error("BitVectors of size " + std::to_string(_size) +
+                                " and " + std::to_string(other._size) +
+                                " cannot be compared");
+
+    //Padding bits are 0 in both so never count as a difference
+    std::size_t distance = 0;
+    for(std::size_t i = 0; i < _words.size(); i++)
+        distance += std::popcount(_words[i] ^ other._words[i]);
+    return distance;
+}
+
+void BitVector::assign(const std::vector<bool>& bits)
+{
+    _size = bits.size();
+    _words.assign((_size + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+    for(std::size_t i = 0; i < _size; i++)
+        if(bits[i])
+            _words[i / BITS_PER_WORD] |= word_type(1) << (i % BITS_PER_WORD);
+}
+
+void BitVector::clear_padding()
+{
+    const std::size_t used_bits = _size % BITS_PER_WORD;
+    if(used_bits != 0)
+        _words.back() &= (word_type(1) << used_bits) - 1;
+}
+
+std::vector<bool> BitVector::to_vector() const
+{
+    std::vector<bool> bits(_size);
+    for(std::size_t i = 0; i < _size; i++)
+        bits[i] = (*this)[i];
+    return bits;
+}
+
+} // namespace NeuroEvo
@@ -0,0 +1,145 @@
+#include <util/concurrency/thread_pool.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace NeuroEvo {
+
+namespace {
+
+//State of one call to parallel_for, shared with the workers helping out
+struct ParallelFor
+{
+    ParallelFor(const std::size_t num_indices,
+                const std::function<void(const std::size_t)>& function) :
+        next_index(0),
+        n(num_indices),
+        func(function),
+        num_active_helpers(0) {}
+
+    //Works through indices until there are none left
+    void run_indices()
+    {
+        for(std::size_t i = next_index.fetch_add(1); i < n; i = next_index.fetch_add(1))
+        {
+            try
+            {
+                func(i);
+            } catch(...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!exception)
+                    exception = std::current_exception();
+                //Abandon the remaining indices
+                next_index.store(n);
+            }
+        }
+    }
+
+    std::atomic<std::size_t> next_index;
+    const std::size_t n;
+    const std::function<void(const std::size_t)>& func;
+
+    //A helper that starts after the indices have run out never calls func, so
+    //the caller only has to wait for the helpers that are active
+    unsigned num_active_helpers;
+    std::mutex mutex;
+    std::condition_variable helpers_done;
+    std::exception_ptr exception;
+};
+
+} // namespace
+
+ThreadPool::ThreadPool(const unsigned num_threads) :
+    _stopping(false)
+{
+    //The thread calling parallel_for is one of the threads
+    const unsigned num_workers = std::max(num_threads, 1u) - 1;
+    _workers.reserve(num_workers);
+    for(unsigned i = 0; i < num_workers; i++)
+        _workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_tasks_mutex);
+        _stopping = true;
+    }
+    _tasks_cv.notify_all();
+
+    for(auto& worker : _workers)
+        worker.join();
+}
+
+void ThreadPool::parallel_for(const std::size_t n,
+                              const std::function<void(const std::size_t)>& func)
+{
+
+    if(n == 0)
+        return;
+
+    auto state = std::make_shared<ParallelFor>(n, func);
+
+    const std::size_t num_helpers = std::min(n - 1, _workers.size());
+    if(num_helpers > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_tasks_mutex);
+            for(std::size_t i = 0; i < num_helpers; i++)
+                _tasks.push_back([state]()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        state->num_active_helpers++;
+                    }
+
+                    state->run_indices();
+
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if(--state->num_active_helpers == 0)
+                        state->helpers_done.notify_all();
+                });
+        }
+        _tasks_cv.notify_all();
+    }
+
+    state->run_indices();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->helpers_done.wait(lock, [&state]()
+                             {return state->num_active_helpers == 0;});
+
+    if(state->exception)
+        std::rethrow_exception(state->exception);
+
+}
+
+unsigned ThreadPool::get_num_threads() const
+{
+    return _workers.size() + 1;
+}
+
+void ThreadPool::work()
+{
+    while(true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(_tasks_mutex);
+            _tasks_cv.wait(lock, [this]() {return _stopping || !_tasks.empty();});
+
+            if(_tasks.empty())
+                return;
+
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+} // namespace NeuroEvo
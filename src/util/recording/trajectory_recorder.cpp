@@ -0,0 +1,172 @@
+#include <util/recording/trajectory_recorder.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace NeuroEvo {
+
+namespace {
+
+const char file_magic[4] = {'N', 'E', 'T', 'R'};
+const uint32_t file_version = 1;
+
+} // namespace
+
+Trajectory::Trajectory(const std::size_t reserved_steps) :
+    _reserved_steps(reserved_steps),
+    _observation_size(0),
+    _action_size(0),
+    _num_steps(0)
+{
+    _rewards.reserve(reserved_steps);
+}
+
+void Trajectory::clear()
+{
+    _observation_size = 0;
+    _action_size = 0;
+    _num_steps = 0;
+    _observations.clear();
+    _actions.clear();
+    _rewards.clear();
+}
+
+void Trajectory::set_sizes(const std::size_t observation_size,
+                           const std::size_t action_size)
+{
+    _observation_size = observation_size;
+    _action_size = action_size;
+    _observations.reserve(_reserved_steps * observation_size);
+    _actions.reserve(_reserved_steps * action_size);
+}
+
+uint32_t Trajectory::get_observation_size() const
+{
+    return _observation_size;
+}
+
+uint32_t Trajectory::get_action_size() const
+{
+    return _action_size;
+}
+
+uint64_t Trajectory::get_num_steps() const
+{
+    return _num_steps;
+}
+
+const std::vector<double>& Trajectory::get_observations() const
+{
+    return _observations;
+}
+
+const std::vector<double>& Trajectory::get_actions() const
+{
+    return _actions;
+}
+
+const std::vector<double>& Trajectory::get_rewards() const
+{
+    return _rewards;
+}
+
+TrajectoryRecorder::TrajectoryRecorder(const std::string& file_name,
+                                       const std::size_t reserved_steps) :
+    _file_name(file_name),
+    _file(file_name, std::ios::binary | std::ios::trunc),
+    _reserved_steps(reserved_steps),
+    _stop(false)
+{
+    if(!_file)
+        throw std::runtime_error("Could not open trajectory file " + file_name);
+
+    _file.write(file_magic, sizeof(file_magic));
+    _file.write(reinterpret_cast<const char*>(&file_version), sizeof(file_version));
+
+    _writer = std::thread(&TrajectoryRecorder::write_trajectories, this);
+}
+
+TrajectoryRecorder::~TrajectoryRecorder()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _trajectory_finished.notify_one();
+    _writer.join();
+}
+
+Trajectory TrajectoryRecorder::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(!_spares.empty())
+        {
+            Trajectory trajectory = std::move(_spares.back());
+            _spares.pop_back();
+            return trajectory;
+        }
+    }
+    return Trajectory(_reserved_steps);
+}
+
+void TrajectoryRecorder::finish(Trajectory&& trajectory)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _finished.push_back(std::move(trajectory));
+    }
+    _trajectory_finished.notify_one();
+}
+
+const std::string& TrajectoryRecorder::get_file_name() const
+{
+    return _file_name;
+}
+
+void TrajectoryRecorder::write_trajectories()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while(true)
+    {
+        _trajectory_finished.wait(lock, [this]() { return _stop || !_finished.empty(); });
+
+        if(_finished.empty())
+            break;
+
+        Trajectory trajectory = std::move(_finished.front());
+        _finished.pop_front();
+
+        //The episodes carry on being recorded while this one is written
+        lock.unlock();
+        write(trajectory);
+        trajectory.clear();
+        lock.lock();
+
+        _spares.push_back(std::move(trajectory));
+    }
+
+    _file.flush();
+}
+
+void TrajectoryRecorder::write(const Trajectory& trajectory)
+{
+    const uint32_t observation_size = trajectory.get_observation_size();
+    const uint32_t action_size = trajectory.get_action_size();
+    //Steps without a reward, as when an episode is cut short, are not written
+    const uint64_t num_steps = std::min<uint64_t>(trajectory.get_num_steps(),
+                                                  trajectory.get_rewards().size());
+
+    _file.write(reinterpret_cast<const char*>(&observation_size), sizeof(observation_size));
+    _file.write(reinterpret_cast<const char*>(&action_size), sizeof(action_size));
+    _file.write(reinterpret_cast<const char*>(&num_steps), sizeof(num_steps));
+
+    _file.write(reinterpret_cast<const char*>(trajectory.get_observations().data()),
+                num_steps * observation_size * sizeof(double));
+    _file.write(reinterpret_cast<const char*>(trajectory.get_actions().data()),
+                num_steps * action_size * sizeof(double));
+    _file.write(reinterpret_cast<const char*>(trajectory.get_rewards().data()),
+                num_steps * sizeof(double));
+}
+
+} // namespace NeuroEvo
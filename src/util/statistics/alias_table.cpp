@@ -0,0 +1,85 @@
+#include <util/statistics/alias_table.h>
+#include <numeric>
+#include <stdexcept>
+
+namespace NeuroEvo {
+
+AliasTable::AliasTable(const std::vector<double>& weights)
+{
+    build(weights);
+}
+
+void AliasTable::build(const std::vector<double>& weights)
+{
+    const std::size_t n = weights.size();
+
+    if(n == 0)
+        throw std::invalid_argument("Cannot build an alias table with no weights");
+
+    _prob.resize(n);
+    _alias.resize(n);
+    _scaled.resize(n);
+    _small.clear();
+    _large.clear();
+
+    const double total_weight = std::accumulate(weights.begin(), weights.end(), 0.);
+
+    //Scale weights such that the average column height is 1
+    for(std::size_t i = 0; i < n; i++)
+    {
+        _scaled[i] = total_weight > 0. ? weights[i] * n / total_weight : 1.;
+        if(_scaled[i] < 1.)
+            _small.push_back(i);
+        else
+            _large.push_back(i);
+    }
+
+    //Vose's method - fill each small column with a piece of a large one
+    while(!_small.empty() && !_large.empty())
+    {
+        const std::size_t s = _small.back();
+        _small.pop_back();
+        const std::size_t l = _large.back();
+
+        _prob[s] = _scaled[s];
+        _alias[s] = l;
+
+        _scaled[l] = (_scaled[l] + _scaled[s]) - 1.;
+        if(_scaled[l] < 1.)
+        {
+            _large.pop_back();
+            _small.push_back(l);
+        }
+    }
+
+    //Anything left over is full up to numerical error
+    for(const auto l : _large)
+    {
+        _prob[l] = 1.;
+        _alias[l] = l;
+    }
+    for(const auto s : _small)
+    {
+        _prob[s] = 1.;
+        _alias[s] = s;
+    }
+}
+
+std::size_t AliasTable::sample(const double uniform_rand) const
+{
+    //Integer part picks the column, fractional part is the biased coin
+    const double scaled_rand = uniform_rand * _prob.size();
+    std::size_t column = static_cast<std::size_t>(scaled_rand);
+    if(column >= _prob.size())
+        column = _prob.size() - 1;
+    const double coin = scaled_rand - static_cast<double>(column);
+
+    return coin < _prob[column] ? column : _alias[column];
+}
+
+std::size_t AliasTable::size() const
+{
+    return _prob.size();
+}
+
+} // namespace NeuroEvo
@@ -0,0 +1,123 @@
+#include <util/statistics/counter_rng.h>
+#include <random>
+
+namespace NeuroEvo {
+
+namespace {
+
+//Philox4x32 constants
+constexpr std::uint32_t PHILOX_M0 = 0xD2511F53;
+constexpr std::uint32_t PHILOX_M1 = 0xCD9E8D57;
+constexpr std::uint32_t PHILOX_W0 = 0x9E3779B9;
+constexpr std::uint32_t PHILOX_W1 = 0xBB67AE85;
+constexpr unsigned PHILOX_ROUNDS = 10;
+
+inline void mulhilo(const std::uint32_t a, const std::uint32_t b,
+                    std::uint32_t& hi, std::uint32_t& lo)
+{
+    const std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(product >> 32);
+    lo = static_cast<std::uint32_t>(product);
+}
+
+} // namespace
+
+CounterRNG::CounterRNG(const std::uint64_t seed, const std::uint64_t stream)
+{
+    this->seed(seed, stream);
+}
+
+void CounterRNG::seed(const std::uint64_t seed, const std::uint64_t stream)
+{
+    _key = seed;
+    _stream = stream;
+    _counter = 0;
+    _buffer_pos = _buffer.size();
+}
+
+void CounterRNG::discard(unsigned long long n)
+{
+    //Skip whole blocks without computing them
+    const std::size_t buffered = _buffer.size() - _buffer_pos;
+    if(n <= buffered)
+    {
+        _buffer_pos += n;
+        return;
+    }
+    n -= buffered;
+    _counter += n / _buffer.size();
+    _buffer_pos = _buffer.size();
+    for(unsigned long long i = 0; i < n % _buffer.size(); i++)
+        (*this)();
+}
+
+std::array<std::uint32_t, 4> CounterRNG::philox(const std::uint64_t seed,
+                                                const std::uint64_t stream,
+                                                const std::uint64_t counter)
+{
+    std::array<std::uint32_t, 4> ctr{
+        static_cast<std::uint32_t>(counter),
+        static_cast<std::uint32_t>(counter >> 32),
+        static_cast<std::uint32_t>(stream),
+        static_cast<std::uint32_t>(stream >> 32)
+    };
+    std::uint32_t k0 = static_cast<std::uint32_t>(seed);
+    std::uint32_t k1 = static_cast<std::uint32_t>(seed >> 32);
+
+    for(unsigned i = 0; i < PHILOX_ROUNDS; i++)
+    {
+        std::uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(PHILOX_M0, ctr[0], hi0, lo0);
+        mulhilo(PHILOX_M1, ctr[2], hi1, lo1);
+        ctr = {hi1 ^ ctr[1] ^ k0, lo1, hi0 ^ ctr[3] ^ k1, lo0};
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    return ctr;
+}
+
+std::uint64_t CounterRNG::draw(const std::uint64_t seed, const std::uint64_t stream,
+                               const std::uint64_t counter)
+{
+    const auto block = philox(seed, stream, counter);
+    return (static_cast<std::uint64_t>(block[1]) << 32) | block[0];
+}
+
+double CounterRNG::uniform(const std::uint64_t seed, const std::uint64_t stream,
+                           const std::uint64_t counter)
+{
+    //Top 53 bits give every representable double in [0, 1) with spacing 2^-53
+    return (draw(seed, stream, counter) >> 11) * 0x1.0p-53;
+}
+
+std::uint64_t CounterRNG::derive_seed(const std::uint64_t seed,
+                                      std::initializer_list<std::uint64_t> ids)
+{
+    //Each id picks a stream of the previous key, the first draw of which
+    //becomes the next key
+    std::uint64_t derived_seed = seed;
+    for(const auto id : ids)
+        derived_seed = draw(derived_seed, id, 0);
+    return derived_seed;
+}
+
+CounterRNG& CounterRNG::thread_local_rng()
+{
+    thread_local CounterRNG rng = []()
+    {
+        std::random_device rand_dev;
+        const std::uint64_t seed =
+            (static_cast<std::uint64_t>(rand_dev()) << 32) | rand_dev();
+        return CounterRNG(seed);
+    }();
+    return rng;
+}
+
+std::uint64_t CounterRNG::random_seed()
+{
+    CounterRNG& rng = thread_local_rng();
+    return (static_cast<std::uint64_t>(rng()) << 32) | rng();
+}
+
+} // namespace NeuroEvo
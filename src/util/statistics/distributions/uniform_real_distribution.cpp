@@ -25,10 +25,13 @@ double UniformRealDistribution::next()
 double UniformRealDistribution::get(
     const double lower_bound,
     const double upper_bound,
-    const std::optional<unsigned> seed)
+    const std::optional<unsigned> seed,
+    const unsigned long counter)
 {
-    UniformRealDistribution distr(lower_bound, upper_bound, seed);
-    return distr.next();
+    const double u = seed.has_value() ?
+                     CounterRNG::uniform(seed.value(), 0, counter) :
+                     std::generate_canonical<double, 53>(CounterRNG::thread_local_rng());
+    return lower_bound + u * (upper_bound - lower_bound);
 }
 
 void UniformRealDistribution::reset()
@@ -23,8 +23,9 @@ unsigned long UniformUnsignedDistribution::next()
 unsigned long UniformUnsignedDistribution::get(const unsigned long lower_bound,
                                                const unsigned long upper_bound)
 {
-    UniformUnsignedDistribution distr(lower_bound, upper_bound);
-    return distr.next();
+    //Draws from the thread local generator rather than seeding a new one
+    std::uniform_int_distribution<unsigned long> distr(lower_bound, upper_bound);
+    return distr(CounterRNG::thread_local_rng());
 }
 
 void UniformUnsignedDistribution::reset()